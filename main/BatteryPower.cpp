@@ -120,7 +120,7 @@ void print_char_val_type(esp_adc_cal_value_t val_type)
 uint32_t batteryVoltage = 0; // unit: mV
 uint8_t batteryPercent = 0;
 unsigned long lastWaringTime = 0;
-DataQueue<uint16_t> batVal(10, true);
+WindowStats<uint16_t, 10> batVal; // Recent readings, the percentage follows the highest.
 unsigned long lastReadBatteryTime = 0;
 unsigned long lastBleUploadTime = 0;
 uint8_t lowPowerWarningCount = 0;
@@ -131,12 +131,10 @@ void bleUploadBatteryInfo()
     {
         if (millis() - lastBleUploadTime > UPLOAD_VOL_TIME)
         {
-            String s = "I#";
-            s = s + batteryVoltage + "#" + batteryPercent + "#\n";
             if (isBleConnected || isWifiConnected)
             {
                 // bleSend(s);
-                mqTx.enterForced(s);
+                mqTx.printfForced("I#%lu#%u#\n", (unsigned long)batteryVoltage, batteryPercent);
             }
             // Serial.println(s);
             lastBleUploadTime = millis();
@@ -156,7 +154,7 @@ void task_BatteryPowerListener(void *pvParameters)
             if (!isRobotMoving)
             {
                 batteryVoltage = getBatteryVoltage();
-                batVal.enterForced(batteryVoltage);
+                batVal.push(batteryVoltage);
                 batteryPercent = constrain((100 * (batVal.getMax() - BAT_VOL_PCT_0) / (BAT_VOL_PCT_100 - BAT_VOL_PCT_0)), 0, 100);
             }
             bleUploadBatteryInfo();
@@ -166,7 +164,7 @@ void task_BatteryPowerListener(void *pvParameters)
                 if (lowPowerWarningCount > 10)
                 {
                     //lowPowerWarningCount = 0;
-                    pca.releaseAllServo();
+                    servoOutputReleaseAll();
                     setMelodyToQueue(MELODY_NO_POWER);
                 }
                 else
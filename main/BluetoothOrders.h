@@ -29,12 +29,24 @@
 #define ACTION_NETWORK						'N'
 #define ACTION_DANCING            'O'
 
+#define ACTION_DIAGNOSTICS        'Q'
+
 #define ACTION_SET_ROBOT            'R'
 
 #define ACTION_TEST               'T'
 
 #define ID_CHECK                  'W'
 
+// ACTION_DIAGNOSTICS items, Q#item# reports, Q#item#1# reports and clears.
+#define DIAG_SERVO_BUS            0
+#define DIAG_SERVO_BUS_TIMING     1
+#define DIAG_MOTION_CLOCK         2
+#define DIAG_IK_TABLE             3
+#define DIAG_STEP_CACHE           4
+#define DIAG_GAIT                 5
+#define DIAG_CORES                6
+#define DIAG_MESSAGES             7
+
 
 
 #endif
@@ -21,7 +21,7 @@ bool isBleConnected = false;
 bool oldBleConnected = false;
 uint8_t txValue = 0;
 
-DataQueue<String> mqTx(100); // Ble message
+MessageQueue<MQ_TX_LENGTH> mqTx; // Ble message
 
 // See the following for generating UUIDs:
 // https://www.uuidgenerator.net/
@@ -34,6 +34,7 @@ class MyServerCallbacks : public BLEServerCallbacks
 {
 	void onConnect(BLEServer *pServer)
 	{
+		bleStream.reset();
 		isBleConnected = true;
 		// connecting
 		if (isBleConnected && !oldBleConnected)
@@ -42,12 +43,13 @@ class MyServerCallbacks : public BLEServerCallbacks
 			oldBleConnected = isBleConnected;
 			Serial.println("ble onConnect");
 			setMelodyToQueue(MELODY_BLE_CONNECT_SUCCESS);
-			enterMessageQueue(String(ACTION_UP_DOWN) + "#1#\n");
+			enterMessageQueue(ACTION_UP_DOWN, "#1#\n");
 		}
 	};
 
 	void onDisconnect(BLEServer *pServer)
 	{
+		bleStream.reset(); // A frame cut by the disconnect must not swallow the next client's bytes.
 		isBleConnected = false;
 		// disconnecting
 		if (!isBleConnected && oldBleConnected)
@@ -57,7 +59,7 @@ class MyServerCallbacks : public BLEServerCallbacks
 			Serial.println("start advertising");
 			oldBleConnected = isBleConnected;
 
-			enterMessageQueue(String(ACTION_UP_DOWN) + "#2#\n");
+			enterMessageQueue(ACTION_UP_DOWN, "#2#\n");
 			setMelodyToQueue(MELODY_BLE_DISCONNECT);
 			// server_Camera.close();
 			// server_Camera.end();
@@ -151,14 +153,25 @@ void bleSend(std::string msg)
 
 void bleSend(String msg)
 {
-	bleSend(std::string(msg.c_str()));
+	bleSend(msg.c_str());
+}
+
+void bleSend(const char *msg)
+{
+	if (isBleConnected)
+	{
+		pTxCharacteristic->setValue((uint8_t *)msg, strlen(msg));
+		pTxCharacteristic->notify();
+	}
 }
 
 void task_BleUploadService(void *pvParameters)
 {
-	if (!mqTx.isEmpty() && isBleConnected)
+	MessageHandle h;
+	if (isBleConnected && mqTx.out(h))
 	{
-		bleSend(mqTx.out());
+		bleSend(messageText(h));
+		messageFree(h);
 	}
 }
 
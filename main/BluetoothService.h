@@ -33,6 +33,7 @@ void bleRestart();
 void bleStop();
 void bleSend(std::string msg);
 void bleSend(String msg);
+void bleSend(const char *msg);
 void task_BleUploadService(void *pvParameters);
 
 extern void onBleReceived(BLECharacteristic *pCharacteristic);
@@ -101,11 +101,15 @@ void playMelody(const int (&tune)[N], const float (&beat)[N], float speed)
 
 bool enableBuzzered = false;
 extern TaskHandle_t taskHandle_Buzzered;
-DataQueue<int> mqBz(20); // Buzzer queue
+MpmcRing<int, MQ_BZ_LENGTH> mqBz; // Buzzer queue
 
 void setMelodyToQueue(int m)
 {
-    mqBz.enterForced(m);
+    int old;
+    if (!mqBz.push(m) && mqBz.pop(old)) // A full queue drops the oldest melody, the new one tells what just happened.
+    {
+        mqBz.push(m);
+    }
     // Serial.printf("setMelodyToQueue %d \n", m);
 }
 
@@ -194,16 +198,21 @@ void task_BuzzerService(void *pvParameters)
         {
             // Serial.printf("taskHandle_Buzzered1 : %d, %d \n", eTaskGetState(taskHandle_Buzzered), taskHandle_Buzzered);
             // cout << "taskHandle_Buzzered1 : " << eTaskGetState(taskHandle_Buzzered) << " " << taskHandle_Buzzered;
-            if (eTaskGetState(taskHandle_Buzzered) == eReady || eTaskGetState(taskHandle_Buzzered) == eDeleted)
+            int m;
+            if ((eTaskGetState(taskHandle_Buzzered) == eReady || eTaskGetState(taskHandle_Buzzered) == eDeleted) && mqBz.pop(m))
             {
-                setMelodyToPlay(mqBz.out());
+                setMelodyToPlay(m);
             }
         }
         else
         {
             // Serial.printf("taskHandle_Buzzered0 : %d ,new task\n", taskHandle_Buzzered);
             // cout << "taskHandle_Buzzered0 : ,new task : "  << " " << taskHandle_Buzzered;
-            setMelodyToPlay(mqBz.out());
+            int m;
+            if (mqBz.pop(m))
+            {
+                setMelodyToPlay(m);
+            }
         }
     }
 }
\ No newline at end of file
@@ -57,54 +57,37 @@ void CameraService::configWifi()
 }
 void CameraService::sendWifiStatus()
 {
-	String s = "";
 	// Serial.printf("WiFi.isConnected(): %d \n", WiFi.isConnected());
 	if (WiFi.isConnected())
 	{
-		s = "N#101#" + String(WiFi.SSID()) + "#" + String(WiFi.localIP().toString()) + "#\n";
+		IPAddress ip = WiFi.localIP();
+		wifi_ap_record_t info; // WiFi.SSID() would build a String.
+		const char *ssid = esp_wifi_sta_get_ap_info(&info) == ESP_OK ? (const char *)info.ssid : "";
+		mqTx.printf("N#101#%s#%u.%u.%u.%u#\n", ssid, ip[0], ip[1], ip[2], ip[3]);
 	}
 	else
 	{
-		s = "N#102#\n";
+		mqTx.enter("N#102#\n");
 	}
-	// bleSend(std::string(s.c_str()));
-	mqTx.enterForced(s);
-	// Serial.print(s);
-	printf("%s\n", s.c_str());
 	// Serial.printf("wifi.getmode :%d \n",WiFi.getMode());
 	if (WiFi.getMode() == WIFI_MODE_AP || WiFi.getMode() == WIFI_MODE_APSTA)
 	{
-		s = "N#301#" + String(ssid_AP) + String("#") + String(WiFi.softAPIP().toString()) + String("#") + String(password_AP) + String("#\n");
+		IPAddress ip = WiFi.softAPIP();
+		mqTx.printf("N#301#%s#%u.%u.%u.%u#%s#\n", ssid_AP, ip[0], ip[1], ip[2], ip[3], password_AP);
 	}
 	else
 	{
-		s = "N#302#\n";
+		mqTx.enter("N#302#\n");
 	}
-	// bleSend(std::string(s.c_str()));
-	mqTx.enterForced(s);
-	// Serial.print(s);
-	printf("%s\n", s.c_str());
 }
 void CameraService::sendCameraStatus()
 {
-	String s = "";
-	if (isCameraNormal)
-	{
-		s = String(ACTION_CAMERA) + "#100#\n";
-	}
-	else
-	{
-		s = String(ACTION_CAMERA) + "#101#\n";
-	}
-	// bleSend(std::string(s.c_str()));
-	mqTx.enterForced(s);
-	Serial.print(s);
+	mqTx.printf("%c#%u#\n", ACTION_CAMERA, isCameraNormal ? 100 : 101);
+	Serial.printf("%c#%u#\n", ACTION_CAMERA, isCameraNormal ? 100 : 101);
 }
 void sendWifiSSID(String ssid)
 {
-	String s = String(ACTION_NETWORK) + String("#") + String("0") + String("#") + ssid + String("#\n");
-	// bleSend(std::string(s.c_str()));
-	mqTx.enterForced(s);
+	mqTx.printf("%c#0#%s#\n", ACTION_NETWORK, ssid.c_str());
 }
 void CameraService::scanWifi()
 {
@@ -166,10 +149,7 @@ void CameraService::establishSoftAP()
 		IPAddress myIP = WiFi.softAPIP();
 		Serial.print("AP IP address: ");
 		Serial.println(myIP);
-		String s = "N#301#" + String(ssid_AP) + String("#") + String(WiFi.softAPIP().toString()) + String("#") + String(password_AP) + String("#\n");
-		Serial.println(s);
-		// bleSend(std::string(s.c_str()));
-		mqTx.enterForced(s);
+		mqTx.printf("N#301#%s#%u.%u.%u.%u#%s#\n", ssid_AP, myIP[0], myIP[1], myIP[2], myIP[3], password_AP);
 		establishCameraServer();
 		setMelodyToQueue(MELODY_WIFI_CONNECT_SUCCESS);
 	}
@@ -190,14 +170,12 @@ void CameraService::closeSoftSTA()
 	setMelodyToQueue(MELODY_WIFI_DISCONNECT);
 }
 
-void CameraService::accessRouter(char *ssid, char *psd)
+void CameraService::accessRouter(const char *ssid, const char *psd)
 {
 	if (WiFi.isConnected() && String(WiFi.SSID()).equals(ssid))
 	{
-		String s = "N#103#\n";
-		// bleSend(std::string(s.c_str()));
-		mqTx.enterForced(s);
-		Serial.println(s);
+		mqTx.enter("N#103#\n");
+		Serial.println("N#103#");
 		sendWifiStatus();
 		Serial.println("WiFi had connected !");
 		setMelodyToQueue(MELODY_WIFI_CONNECT_SUCCESS);
@@ -224,10 +202,8 @@ void CameraService::accessRouter(char *ssid, char *psd)
 			// WiFi.setTxPower(WIFI_POWER_19_5dBm);
 			esp_wifi_set_max_tx_power(84);
 			Serial.printf("Set Tx Power: %d\n", WiFi.getTxPower());
-			String s = "N#103#\n";
-			// bleSend(std::string(s.c_str()));
-			mqTx.enterForced(s);
-			Serial.println(s);
+			mqTx.enter("N#103#\n");
+			Serial.println("N#103#");
 			Serial.println("WiFi connect successes!");
 			sendWifiStatus();
 			setMelodyToQueue(MELODY_WIFI_CONNECT_SUCCESS);
@@ -235,9 +211,7 @@ void CameraService::accessRouter(char *ssid, char *psd)
 		}
 		else
 		{
-			String s = "N#104#\n";
-			// bleSend(std::string(s.c_str()));
-			mqTx.enterForced(s);
+			mqTx.enter("N#104#\n");
 			Serial.println("");
 			Serial.println("WiFi connect failed!");
 			setMelodyToQueue(MELODY_WIFI_CONNECT_FAILED);
@@ -245,15 +219,6 @@ void CameraService::accessRouter(char *ssid, char *psd)
 	}
 }
 
-void CameraService::accessRouter(String ssid, String psd)
-{
-	char *c_ssid = (char *)malloc(ssid.length());
-	char *c_psd = (char *)malloc(psd.length());
-	strcpy(c_ssid, ssid.c_str());
-	strcpy(c_psd, psd.c_str());
-	accessRouter(c_ssid, c_psd);
-}
-
 void CameraService::establishCameraServer(u16 port)
 {
 	if (WiFi.isConnected() || (WiFi.getMode() == WIFI_MODE_AP || WiFi.getMode() == WIFI_MODE_APSTA))
@@ -500,6 +465,7 @@ void task_CmdService(void *pvParameters)
 			}
 			// close the connection:
 			client.stop();
+			wifiStream.reset();
 			isWifiConnected = false;
 			Serial.println("Command Client Disconnected.");
 			bleRestart();
@@ -68,8 +68,7 @@ public:
 	void establishSoftAP();
 	void closeSoftAP();
 
-	void accessRouter(char *ssid, char *psd);
-	void accessRouter(String ssid, String psd);
+	void accessRouter(const char *ssid, const char *psd);
 	void closeSoftSTA();
 
 	void establishCameraServer(u16 port = CAMERA_SERVER_PORT);
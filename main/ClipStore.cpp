@@ -0,0 +1,205 @@
+/**
+ * @file ClipStore.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Read-only motion clips in the "motion" flash partition, memory mapped and played in place.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "ClipStore.h"
+#include <SPIFFS.h>
+#include "esp_partition.h"
+
+#define CLIP_COPY_BYTES 512 // Chunk copied from SPIFFS to the partition by clipStorePack().
+
+static const esp_partition_t *clipPartition = NULL;
+static const u8 *clipBase = NULL; // Mapped partition, NULL while unmapped.
+static spi_flash_mmap_handle_t clipHandle;
+
+static bool clipFindPartition()
+{
+	if (clipPartition == NULL)
+	{
+		clipPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)CLIP_STORE_SUBTYPE, CLIP_STORE_LABEL);
+	}
+	return clipPartition != NULL;
+}
+
+static const ClipStoreManifest *clipManifest()
+{
+	return (const ClipStoreManifest *)clipBase;
+}
+
+/**
+ * @brief Map the partition into the data cache. The clips are then read in place, no copies and no file system.
+ *
+ * @return Whether a valid manifest is mapped.
+ */
+bool clipStoreOpen()
+{
+	if (clipBase == NULL)
+	{
+		if (!clipFindPartition())
+		{
+			return false;
+		}
+		const void *p;
+		if (esp_partition_mmap(clipPartition, 0, clipPartition->size, SPI_FLASH_MMAP_DATA, &p, &clipHandle) != ESP_OK)
+		{
+			return false;
+		}
+		clipBase = (const u8 *)p;
+	}
+	return clipManifest()->magic == CLIP_STORE_MAGIC && clipManifest()->version == CLIP_STORE_VERSION;
+}
+
+static void clipStoreClose()
+{
+	if (clipBase != NULL)
+	{
+		spi_flash_munmap(clipHandle);
+		clipBase = NULL;
+	}
+}
+
+// The header of clip id, or NULL. The frames follow it, and their holds add up to its ticks.
+static const TimelineHeader *clipFind(u8 id)
+{
+	if (id >= CLIP_STORE_MAX || !clipStoreOpen())
+	{
+		return NULL;
+	}
+	u32 offset = clipManifest()->offset[id];
+	u32 size = clipPartition->size;
+	if (offset == 0 || offset > size || size - offset < sizeof(TimelineHeader))
+	{
+		return NULL;
+	}
+	const TimelineHeader *hdr = (const TimelineHeader *)(clipBase + offset);
+	// Compared as a count, hdr->frames * sizeof(TimelineFrame) can wrap.
+	if (!timelineIsValid(*hdr) || hdr->frames > (size - offset - sizeof(TimelineHeader)) / sizeof(TimelineFrame))
+	{
+		return NULL;
+	}
+	const TimelineFrame *frames = (const TimelineFrame *)(hdr + 1);
+	uint64_t ticks = 0;
+	for (u32 i = 0; i < hdr->frames; i++)
+	{
+		ticks += frames[i].hold;
+	}
+	return ticks == hdr->ticks ? hdr : NULL;
+}
+
+bool clipExists(u8 id)
+{
+	return clipFind(id) != NULL;
+}
+
+/**
+ * @brief Play clip id from flash, as timelinePlay() does from SPIFFS.
+ *
+ * @return false if there is no valid clip id, nothing is moved then.
+ */
+bool clipPlay(u8 id)
+{
+	const TimelineHeader *hdr = clipFind(id);
+	if (hdr == NULL)
+	{
+		return false;
+	}
+	const TimelineFrame *frames = (const TimelineFrame *)(hdr + 1);
+	float startPt[4][3];
+	memcpy(startPt, hdr->startPt, sizeof(startPt));
+	action_twist(lastPt, startPt, TIMELINE_APPROACH_SPEED);
+
+	int i = -1;
+	int frameEnd = 0; // First tick after frames[i].
+	int lastTick = hdr->ticks - 1;
+	motionClockStart();
+	for (int t = 0; t <= lastTick; t = motionTick(t, lastTick))
+	{
+		if (frameEnd > t)
+		{
+			continue;
+		}
+		while (frameEnd <= t && i + 1 < (int)hdr->frames)
+		{
+			frameEnd += frames[++i].hold;
+		}
+		timelineShowFrame(frames[i]); // Straight from the flash cache.
+	}
+	memcpy(lastPt, hdr->endPt, sizeof(hdr->endPt));
+	return true;
+}
+
+/**
+ * @brief Take clip id out of the manifest, so a timeline recorded under the same id plays instead of it
+ * until the next pack. Only bits are cleared, which needs no erase.
+ */
+bool clipRemove(u8 id)
+{
+	if (clipFind(id) == NULL)
+	{
+		return false;
+	}
+	u32 none = 0;
+	size_t at = offsetof(ClipStoreManifest, offset) + id * sizeof(u32);
+	clipStoreClose(); // Mapped again by the next clipStoreOpen(), past the write.
+	return esp_partition_write(clipPartition, at, &none, sizeof(none)) == ESP_OK;
+}
+
+/**
+ * @brief Pack the SPIFFS timelines into the partition, replacing its clips. The manifest is written
+ * last, so an interrupted pack leaves no valid store.
+ *
+ * @return Clips packed, -1 on a flash error.
+ */
+int clipStorePack()
+{
+	clipStoreClose(); // The partition is rewritten under the mapping.
+	if (!clipFindPartition() || !timelineMount() || esp_partition_erase_range(clipPartition, 0, clipPartition->size) != ESP_OK)
+	{
+		return -1;
+	}
+	ClipStoreManifest manifest;
+	memset(&manifest, 0, sizeof(manifest));
+	manifest.magic = CLIP_STORE_MAGIC;
+	manifest.version = CLIP_STORE_VERSION;
+	u32 offset = (sizeof(manifest) + 3) & ~3;
+	u8 buf[CLIP_COPY_BYTES];
+	for (u8 id = 0; id < CLIP_STORE_MAX; id++)
+	{
+		File f = SPIFFS.open(timelinePath(id).c_str(), FILE_READ);
+		if (!f)
+		{
+			continue;
+		}
+		size_t size = f.size();
+		if (offset + size > clipPartition->size)
+		{
+			f.close();
+			break; // Full.
+		}
+		size_t n, copied = 0;
+		while ((n = f.read(buf, sizeof(buf))) > 0 && esp_partition_write(clipPartition, offset + copied, buf, n) == ESP_OK)
+		{
+			copied += n;
+		}
+		f.close();
+		if (copied == size)
+		{
+			manifest.offset[id] = offset;
+			manifest.count++;
+		}
+		offset = (offset + size + 3) & ~3;
+	}
+	if (esp_partition_write(clipPartition, 0, &manifest, sizeof(manifest)) != ESP_OK)
+	{
+		return -1;
+	}
+	Serial.printf("Clip store: %d clips, %lu bytes\n", manifest.count, (unsigned long)offset);
+	return manifest.count;
+}
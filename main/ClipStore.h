@@ -0,0 +1,40 @@
+/**
+ * @file ClipStore.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Read-only motion clips in the "motion" flash partition, memory mapped and played in place.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _CLIPSTORE_h
+#define _CLIPSTORE_h
+
+#include "Public.h"
+
+#define CLIP_STORE_LABEL	"motion"
+#define CLIP_STORE_SUBTYPE	0x40		//Custom data subtype of the partition in huge_app.csv.
+#define CLIP_STORE_MAGIC	0x53434E46	//"FNCS".
+#define CLIP_STORE_VERSION	1
+#define CLIP_STORE_MAX		32			//Clip ids 0~CLIP_STORE_MAX-1, the same ids as the timelines.
+
+//Partition layout: this manifest at offset 0, then the clips. A clip is a timeline file,
+//TimelineHeader followed by its frames, at a 4 byte aligned offset. Also packed by the host, hence uint32_t.
+struct ClipStoreManifest
+{
+	uint32_t magic;
+	u16 version;
+	u16 count;							//Clips present.
+	uint32_t offset[CLIP_STORE_MAX];	//Offset of clip id in the partition, 0: no clip.
+};
+static_assert(sizeof(ClipStoreManifest) == 8 + 4 * CLIP_STORE_MAX, "Clip store layout");
+
+bool clipStoreOpen();
+bool clipPlay(u8 id);
+bool clipExists(u8 id);
+bool clipRemove(u8 id);
+int clipStorePack();
+
+#endif
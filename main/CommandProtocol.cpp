@@ -0,0 +1,263 @@
+/**
+ * @file CommandProtocol.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Per connection command input. Text lines "C#p1#p2#...#\n" and binary frames are told apart by their first byte.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "CommandProtocol.h"
+
+#define STREAM_TEXT			0
+#define STREAM_VERSION		1
+#define STREAM_TYPE			2
+#define STREAM_LENGTH		3
+#define STREAM_PAYLOAD		4
+#define STREAM_CRC_LOW		5
+#define STREAM_CRC_HIGH		6
+
+struct ProtocolCommand
+{
+	char type;
+	const char *layout;
+};
+
+static const ProtocolCommand protocolCommands[] = {
+	{ACTION_UP_DOWN, PROTOCOL_LAYOUT_UP_DOWN},
+	{ACTION_BODY_HEIGHT, PROTOCOL_LAYOUT_BODY_HEIGHT},
+	{ACTION_RGB, PROTOCOL_LAYOUT_RGB},
+	{ACTION_BUZZER, PROTOCOL_LAYOUT_BUZZER},
+	{ACTION_TWIST, PROTOCOL_LAYOUT_TWIST},
+	{ACTION_MOVE_ANY, PROTOCOL_LAYOUT_MOVE_ANY},
+	{ACTION_ULTRASONIC, PROTOCOL_LAYOUT_ULTRASONIC},
+	{ACTION_GET_VOLTAGE, PROTOCOL_LAYOUT_GET_VOLTAGE},
+	{ACTION_CALIBRATE, PROTOCOL_LAYOUT_CALIBRATE},
+	{ACTION_SET_NVS, PROTOCOL_LAYOUT_SET_NVS},
+	{ACTION_INSTALLATION, PROTOCOL_LAYOUT_INSTALLATION},
+	{ACTION_AUTO_WALKING, PROTOCOL_LAYOUT_AUTO_WALKING},
+	{ACTION_NETWORK, PROTOCOL_LAYOUT_NETWORK},
+	{ACTION_DANCING, PROTOCOL_LAYOUT_DANCING},
+	{ACTION_DIAGNOSTICS, PROTOCOL_LAYOUT_DIAGNOSTICS},
+	{ACTION_SET_ROBOT, PROTOCOL_LAYOUT_SET_ROBOT},
+	{ACTION_TEST, PROTOCOL_LAYOUT_TEST},
+	{ID_CHECK, PROTOCOL_LAYOUT_ID_CHECK},
+};
+
+static const char *protocolLayoutOf(char type)
+{
+	for (u8 i = 0; i < sizeof(protocolCommands) / sizeof(protocolCommands[0]); i++)
+	{
+		if (protocolCommands[i].type == type)
+		{
+			return protocolCommands[i].layout;
+		}
+	}
+	return NULL;
+}
+
+static int32_t protocolReadInt(char field, const u8 *p)
+{
+	switch (field)
+	{
+	case 'B':
+		return p[0];
+	case 'h':
+		return (int16_t)(p[0] | p[1] << 8);
+	case 'H':
+		return (u16)(p[0] | p[1] << 8);
+	default:
+		return (int32_t)(p[0] | p[1] << 8 | p[2] << 16 | (u32)p[3] << 24);
+	}
+}
+
+// CRC-16/CCITT-FALSE of each high byte, 0x1021 shifted through it eight times. 512 bytes of flash.
+static const u16 protocolCrcTable[256] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+	0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+	0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+	0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+	0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+	0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+	0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+	0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+	0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+	0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+	0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+	0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+	0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+	0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+	0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+	0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+	0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+	0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+	0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+	0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+	0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+	0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+	0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+	0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+	0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+	0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+	0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+	0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+	0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+	0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+	0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+/**
+ * @brief CRC-16/CCITT-FALSE, polynomial 0x1021, one table lookup per byte. Pass the last result as crc to continue over more bytes.
+ */
+u16 protocolCrc16(const u8 *data, size_t length, u16 crc)
+{
+	for (size_t i = 0; i < length; i++)
+	{
+		crc = (crc << 8) ^ protocolCrcTable[(crc >> 8) ^ data[i]];
+	}
+	return crc;
+}
+
+CommandStream::CommandStream()
+{
+	reset();
+}
+
+/**
+ * @brief Forget a half received line or frame. Call when the connection changes, so the next client starts clean.
+ */
+void CommandStream::reset()
+{
+	state = STREAM_TEXT;
+	lineLength = 0;
+	isFrameDropped = false;
+}
+
+/**
+ * @brief Take the bytes received on this connection. 0xA5 at the start of a line opens a binary frame,
+ * anything else is text up to '\n'. A frame of another version, too long or with a bad crc is still read
+ * to its end by its length, then dropped, so none of its bytes can turn up in a text line.
+ */
+void CommandStream::feed(const u8 *data, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		u8 c = data[i];
+		switch (state)
+		{
+		case STREAM_TEXT:
+			if (c == PROTOCOL_SYNC && lineLength == 0)
+			{
+				state = STREAM_VERSION;
+				break;
+			}
+			if (lineLength < MESSAGE_LENGTH_MAX || c == '\n') // A long line is cut, but still ends on its '\n'.
+			{
+				line[lineLength++] = c;
+			}
+			if (c == '\n')
+			{
+				line[lineLength] = '\0';
+				enterMessageQueue(line);
+				lineLength = 0;
+			}
+			break;
+		case STREAM_VERSION:
+			crc = protocolCrc16(&c, 1);
+			isFrameDropped = c != PROTOCOL_VERSION;
+			state = STREAM_TYPE;
+			break;
+		case STREAM_TYPE:
+			crc = protocolCrc16(&c, 1, crc);
+			type = c;
+			state = STREAM_LENGTH;
+			break;
+		case STREAM_LENGTH:
+			crc = protocolCrc16(&c, 1, crc);
+			length = c;
+			received = 0;
+			isFrameDropped = isFrameDropped || length > PROTOCOL_PAYLOAD_MAX;
+			state = length > 0 ? STREAM_PAYLOAD : STREAM_CRC_LOW;
+			break;
+		case STREAM_PAYLOAD:
+			if (received < PROTOCOL_PAYLOAD_MAX)
+			{
+				payload[received] = c;
+			}
+			received++;
+			if (received == length)
+			{
+				crc = isFrameDropped ? crc : protocolCrc16(payload, length, crc);
+				state = STREAM_CRC_LOW;
+			}
+			break;
+		case STREAM_CRC_LOW:
+			frameCrc = c;
+			state = STREAM_CRC_HIGH;
+			break;
+		default:
+			frameCrc |= c << 8;
+			if (!isFrameDropped && frameCrc == crc)
+			{
+				enterFrame();
+			}
+			state = STREAM_TEXT;
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Hand a checked frame on exactly as its text line would be: motion commands straight to the mailbox,
+ * the others as the equivalent text line to mqInfo. Names and secrets must not contain '#'.
+ */
+void CommandStream::enterFrame()
+{
+	const char *layout = protocolLayoutOf(type);
+	if (layout == NULL || length != protocolLayoutSize(layout))
+	{
+		return;
+	}
+	bool isMotion = isMotionCommand(type);
+	MotionCommand cmd;
+	memset(&cmd, 0, sizeof(cmd));
+	cmd.commandChar = type;
+	int n = isMotion ? 0 : snprintf(line, sizeof(line), "%c#", type); // A motion command needs no text.
+	const u8 *p = payload;
+	u8 fields = 0;
+	for (const char *f = layout; *f != 0; f++)
+	{
+		size_t size = protocolFieldSize(*f);
+		if (*f == 's' || *f == 'S')
+		{
+			n += snprintf(line + n, sizeof(line) - n, "%.*s#", (int)strnlen((const char *)p, size - 1), (const char *)p);
+		}
+		else
+		{
+			int32_t value = protocolReadInt(*f, p);
+			if (isMotion)
+			{
+				cmd.paramters[fields + 1] = value;
+			}
+			else
+			{
+				n += snprintf(line + n, sizeof(line) - n, "%ld#", (long)value);
+			}
+		}
+		fields++;
+		p += size;
+	}
+	if (isMotion)
+	{
+		cmd.paramterCount = fields;
+		motionMailboxPost(cmd);
+	}
+	else
+	{
+		snprintf(line + n, sizeof(line) - n, "\n");
+		enterMessageQueue(line);
+	}
+}
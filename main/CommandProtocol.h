@@ -0,0 +1,117 @@
+/**
+ * @file CommandProtocol.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Per connection command input. Text lines "C#p1#p2#...#\n" and binary frames are told apart by their first byte.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ * Binary frame, little-endian:
+ * 0xA5 | version | type | length | payload[length] | crc16 low | crc16 high
+ * type is the command word of BluetoothOrders.h and the payload the fixed struct of that command below,
+ * its fields are the text parameters in the same order. crc16 is CRC-16/CCITT-FALSE over version ~ payload.
+ * Replies are sent as text.
+ */
+
+#ifndef _COMMANDPROTOCOL_h
+#define _COMMANDPROTOCOL_h
+
+#include "Public.h"
+
+#define PROTOCOL_SYNC			0xA5	//Never an ASCII byte, so it cannot start a text line.
+#define PROTOCOL_VERSION		1
+#define PROTOCOL_PAYLOAD_MAX	128
+#define PROTOCOL_NAME_LENGTH	33		//'s' field: ssid or code, '\0' padded.
+#define PROTOCOL_SECRET_LENGTH	65		//'S' field: password, '\0' padded.
+
+//Payload layout of each command, one letter per field: B u8, h int16, H u16, i int32, s name, S secret.
+#define PROTOCOL_LAYOUT_UP_DOWN			"B"		//A mode
+#define PROTOCOL_LAYOUT_BODY_HEIGHT		"h"		//B height
+#define PROTOCOL_LAYOUT_RGB				"BBBB"	//C mode, r, g, b
+#define PROTOCOL_LAYOUT_BUZZER			"H"		//D frequency
+#define PROTOCOL_LAYOUT_TWIST			"hhhhhh"	//E pitch, roll, yaw, x, y, z
+#define PROTOCOL_LAYOUT_MOVE_ANY		"hhhB"	//F alpha, step length, gama, speed
+#define PROTOCOL_LAYOUT_ULTRASONIC		""		//H
+#define PROTOCOL_LAYOUT_GET_VOLTAGE		""		//I
+#define PROTOCOL_LAYOUT_CALIBRATE		"BBhhh"	//J leg, operation, x, y, z
+#define PROTOCOL_LAYOUT_SET_NVS			"Bi"	//K item, value
+#define PROTOCOL_LAYOUT_INSTALLATION	"B"		//L position
+#define PROTOCOL_LAYOUT_AUTO_WALKING	"B"		//M enable
+#define PROTOCOL_LAYOUT_NETWORK			"BsS"	//N operation, ssid, password
+#define PROTOCOL_LAYOUT_DANCING			"BB"	//O id, mode
+#define PROTOCOL_LAYOUT_DIAGNOSTICS		"BB"	//Q item, clear
+#define PROTOCOL_LAYOUT_SET_ROBOT		"B"		//R speed
+#define PROTOCOL_LAYOUT_TEST			""		//T
+#define PROTOCOL_LAYOUT_ID_CHECK		"Bs"	//W operation, code
+
+constexpr size_t protocolFieldSize(char field)
+{
+	return field == 'B' ? 1 : field == 'h' || field == 'H' ? 2 : field == 'i' ? 4 : field == 's' ? PROTOCOL_NAME_LENGTH : PROTOCOL_SECRET_LENGTH;
+}
+
+constexpr size_t protocolLayoutSize(const char *layout)
+{
+	return *layout == 0 ? 0 : protocolFieldSize(*layout) + protocolLayoutSize(layout + 1);
+}
+
+#pragma pack(push, 1)
+struct ProtocolUpDown { u8 mode; };
+struct ProtocolBodyHeight { int16_t height; };
+struct ProtocolRGB { u8 mode, r, g, b; };
+struct ProtocolBuzzer { u16 frequency; };
+struct ProtocolTwist { int16_t pitch, roll, yaw, x, y, z; };
+struct ProtocolMoveAny { int16_t alpha, stepLength, gama; u8 speed; };
+struct ProtocolCalibrate { u8 leg, operation; int16_t x, y, z; };
+struct ProtocolSetNvs { u8 item; int32_t value; };
+struct ProtocolInstallation { u8 position; };
+struct ProtocolAutoWalking { u8 enable; };
+struct ProtocolNetwork { u8 operation; char ssid[PROTOCOL_NAME_LENGTH]; char password[PROTOCOL_SECRET_LENGTH]; };
+struct ProtocolDancing { u8 id, mode; };
+struct ProtocolDiagnostics { u8 item, clear; };
+struct ProtocolSetRobot { u8 speed; };
+struct ProtocolIdCheck { u8 operation; char code[PROTOCOL_NAME_LENGTH]; };
+#pragma pack(pop)
+
+static_assert(sizeof(ProtocolUpDown) == protocolLayoutSize(PROTOCOL_LAYOUT_UP_DOWN), "A layout");
+static_assert(sizeof(ProtocolBodyHeight) == protocolLayoutSize(PROTOCOL_LAYOUT_BODY_HEIGHT), "B layout");
+static_assert(sizeof(ProtocolRGB) == protocolLayoutSize(PROTOCOL_LAYOUT_RGB), "C layout");
+static_assert(sizeof(ProtocolBuzzer) == protocolLayoutSize(PROTOCOL_LAYOUT_BUZZER), "D layout");
+static_assert(sizeof(ProtocolTwist) == protocolLayoutSize(PROTOCOL_LAYOUT_TWIST), "E layout");
+static_assert(sizeof(ProtocolMoveAny) == protocolLayoutSize(PROTOCOL_LAYOUT_MOVE_ANY), "F layout");
+static_assert(sizeof(ProtocolCalibrate) == protocolLayoutSize(PROTOCOL_LAYOUT_CALIBRATE), "J layout");
+static_assert(sizeof(ProtocolSetNvs) == protocolLayoutSize(PROTOCOL_LAYOUT_SET_NVS), "K layout");
+static_assert(sizeof(ProtocolInstallation) == protocolLayoutSize(PROTOCOL_LAYOUT_INSTALLATION), "L layout");
+static_assert(sizeof(ProtocolAutoWalking) == protocolLayoutSize(PROTOCOL_LAYOUT_AUTO_WALKING), "M layout");
+static_assert(sizeof(ProtocolNetwork) == protocolLayoutSize(PROTOCOL_LAYOUT_NETWORK), "N layout");
+static_assert(sizeof(ProtocolDancing) == protocolLayoutSize(PROTOCOL_LAYOUT_DANCING), "O layout");
+static_assert(sizeof(ProtocolDiagnostics) == protocolLayoutSize(PROTOCOL_LAYOUT_DIAGNOSTICS), "Q layout");
+static_assert(sizeof(ProtocolSetRobot) == protocolLayoutSize(PROTOCOL_LAYOUT_SET_ROBOT), "R layout");
+static_assert(sizeof(ProtocolIdCheck) == protocolLayoutSize(PROTOCOL_LAYOUT_ID_CHECK), "W layout");
+static_assert(protocolLayoutSize(PROTOCOL_LAYOUT_NETWORK) <= PROTOCOL_PAYLOAD_MAX, "payload");
+
+u16 protocolCrc16(const u8 *data, size_t length, u16 crc = 0xFFFF);
+
+class CommandStream
+{
+private:
+	u8 state;
+	u8 type, length, received;
+	u16 crc, frameCrc;
+	bool isFrameDropped;	//Wrong version or too long, read to its end but not handed on.
+	u8 payload[PROTOCOL_PAYLOAD_MAX];
+	char line[MESSAGE_LENGTH_MAX + 2];
+	u8 lineLength;
+
+	void enterFrame();
+
+public:
+	CommandStream();
+	void reset();
+	void feed(const u8 *data, size_t size);
+};
+
+extern CommandStream bleStream;		// Command input of the BLE connection.
+extern CommandStream wifiStream;	// Command input of the WiFi command client.
+
+#endif
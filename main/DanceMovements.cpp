@@ -26,7 +26,7 @@ void danceDancing()
 			for (int j = 0; j < 2; j++)
 			{
 				twist_any(acts[i][j][0], acts[i][j][1], acts[i][j][2]);
-				vTaskDelay(20);
+				motionPause(20);
 			}
 		}
 	}
@@ -36,8 +36,8 @@ void danceDancing()
 	{
 		for (int i = 0; i < 360; i += 30)
 		{
-			x = 10 * sin((double)i * PI / 180);
-			z = 10 * cos((double)i * PI / 180);
+			x = 10 * fastSinDeg(i);
+			z = 10 * fastCosDeg(i);
 			twist_any(x, y, z);
 		}
 	}
@@ -45,9 +45,9 @@ void danceDancing()
 	for (int i = 0; i < repeatCounts; i++)
 	{
 		setBodyHeight(BODY_HEIGHT_MIN);
-		vTaskDelay(200);
+		motionPause(200);
 		setBodyHeight(BODY_HEIGHT_MAX);
-		vTaskDelay(200);
+		motionPause(200);
 	}
 	twist_any(0, 0, 0);
 }
@@ -59,9 +59,9 @@ void danceSitDown()
 						 {calibratePosition[2][0], calibratePosition[2][1] - 30, calibratePosition[2][2]},
 						 {calibratePosition[3][0], calibratePosition[3][1] + 30, calibratePosition[3][2]}};
 	action_twist(lastPt, newPt, spd);
-	vTaskDelay(3000);
+	motionPause(3000);
 	action_twist(lastPt, calibratePosition, spd);
-	vTaskDelay(200);
+	motionPause(200);
 	standUp();
 }
 void danceTurnAround()
@@ -85,10 +85,10 @@ void danceStretchSelf()
 						 {calibratePosition[2][0], calibratePosition[2][1] + 30, calibratePosition[2][2]},
 						 {calibratePosition[3][0] + 95, calibratePosition[3][1] - 56, calibratePosition[3][2]}};
 	action_twist(lastPt, newPt, spd);
-	vTaskDelay(2000);
+	motionPause(2000);
 
 	action_twist(lastPt, calibratePosition, spd);
-	vTaskDelay(200);
+	motionPause(200);
 	standUp();
 }
 void dancePushUp()
@@ -100,18 +100,18 @@ void dancePushUp()
 						 {calibratePosition[2][0] - 80, calibratePosition[2][1] + 10, calibratePosition[2][2]},
 						 {calibratePosition[3][0], calibratePosition[3][1] + 20, calibratePosition[3][2]}};
 	action_twist(lastPt, newPt, spd);
-	vTaskDelay(200);
+	motionPause(200);
 
 	for (int i = 0; i < repeats; i++)
 	{
 		newPt[0][1] = calibratePosition[0][1] - 20;
 		newPt[3][1] = calibratePosition[3][1] - 20;
 		action_twist(lastPt, newPt, spd);
-		vTaskDelay(200);
+		motionPause(200);
 		newPt[0][1] = calibratePosition[0][1] + 20;
 		newPt[3][1] = calibratePosition[3][1] + 20;
 		action_twist(lastPt, newPt, spd);
-		vTaskDelay(200);
+		motionPause(200);
 	}
 
 	action_twist(lastPt, calibratePosition, spd);
@@ -130,7 +130,7 @@ void danceSayHello()
 	newPt[3][1] = calibratePosition[3][1] - 90;
 	newPt[3][2] = calibratePosition[3][2] + 10;
 	action_twist(lastPt, newPt, spd);
-	vTaskDelay(200);
+	motionPause(200);
 	for (int i = 0; i < repeats; i++)
 	{
 		newPt[3][2] = calibratePosition[3][2] + 5;
@@ -139,7 +139,7 @@ void danceSayHello()
 		action_twist(lastPt, newPt, spd);
 		newPt[3][2] = calibratePosition[3][2] - 5;
 		action_twist(lastPt, newPt, spd);
-		vTaskDelay(200);
+		motionPause(200);
 
 		newPt[3][2] = calibratePosition[3][2] + 0;
 		action_twist(lastPt, newPt, spd);
@@ -147,7 +147,7 @@ void danceSayHello()
 		action_twist(lastPt, newPt, spd);
 		newPt[3][2] = calibratePosition[3][2] + 10;
 		action_twist(lastPt, newPt, spd);
-		vTaskDelay(200);
+		motionPause(200);
 	}
 
 	newPt[3][0] = calibratePosition[3][0];
@@ -156,4 +156,43 @@ void danceSayHello()
 	action_twist(lastPt, newPt, spd);
 
 	action_twist(lastPt, calibratePosition, spd);
-}
\ No newline at end of file
+}
+static void (*const danceRoutines[DANCE_COUNT])() = {danceSayHello, dancePushUp, danceStretchSelf, danceTurnAround, danceSitDown, danceDancing};
+
+/**
+ * @brief Dance id. A clip in the motion partition or a recorded timeline plays without inverse kinematics,
+ * the routine is the fallback.
+ *
+ * @param mode DANCE_MODE_PLAY, DANCE_MODE_RECORD or DANCE_MODE_REMOVE.
+ */
+void dance(u8 id, u8 mode)
+{
+	if (id >= DANCE_COUNT)
+	{
+		return;
+	}
+	switch (mode)
+	{
+	case DANCE_MODE_RECORD:
+		clipRemove(id); // The packed clip would otherwise hide the new recording.
+		timelineRecordBegin(id);
+		danceRoutines[id]();
+		gaitFinishStride();
+		timelineRecordEnd();
+		break;
+	case DANCE_MODE_REMOVE:
+		clipRemove(id);
+		timelineRemove(id);
+		break;
+	case DANCE_MODE_PACK: // On the motion task, so no clip is playing while the partition is rewritten.
+		clipStorePack();
+		break;
+	default:
+		if (!clipPlay(id) && !timelinePlay(id))
+		{
+			danceRoutines[id]();
+			gaitFinishStride(); // move_any() leaves its last stride running.
+		}
+		break;
+	}
+}
@@ -22,6 +22,12 @@
 #define DANCE_TURN_AROUND       3
 #define DANCE_SIT_DOWN          4
 #define DANCE_DANCING           5
+#define DANCE_COUNT             6
+
+#define DANCE_MODE_PLAY         0   //O#id# plays the dance clip in flash, its recorded timeline, or runs its routine.
+#define DANCE_MODE_RECORD       1   //O#id#1# runs the routine and records it as the timeline, its clip is dropped.
+#define DANCE_MODE_REMOVE       2   //O#id#2# removes the timeline and its clip.
+#define DANCE_MODE_PACK         3   //O#0#3# packs all the timelines into the motion clip partition.
 
 
 void danceSayHello();
@@ -30,6 +36,7 @@ void danceStretchSelf();
 void danceTurnAround();
 void danceSitDown();
 void danceDancing();
+void dance(u8 id, u8 mode);
 
 
 
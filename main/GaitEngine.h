@@ -0,0 +1,47 @@
+/**
+ * @file GaitEngine.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Tick-stepped walking gait. The stride target can change at any tick, the legs retarget from where they are.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _GAITENGINE_h
+#define _GAITENGINE_h
+
+#include "Public.h"
+
+#define GAIT_CONTINUOUS -1 //gaitSetTarget() halves: keep walking until the next target.
+
+//Blending of a continuous walk: the stride setpoint moves towards the command by at most
+//these steps per tick, so ground speed changes with bounded acceleration.
+#define GAIT_BLEND_STEP		1.0f		//Stride length, unit: mm / tick.
+#define GAIT_BLEND_SPIN		1.0f		//Spin angle, unit: degree / tick.
+#define GAIT_FOOT_SPEED_MAX	SPEED_MAX	//A retargeted half step is stretched so no foot moves faster, unit: mm / tick.
+
+#define GAIT_QUEUE_LENGTH	4				//Segments waiting behind the running one.
+#define GAIT_GAP_WINDOW_US	1000000			//A restart later than this after the gait stopped is a new walk, not a gap.
+
+struct GaitStats
+{
+	u32 segments;		//Segments started.
+	u32 handovers;		//Segments that took over from a queued predecessor at a half step boundary, no idle tick.
+	u32 restarts;		//Segments that started a stopped gait within GAIT_GAP_WINDOW_US.
+	u32 maxGapUs;		//Longest idle time before a restart, unit: us.
+	uint64_t totalGapUs;
+};
+
+//A stride is two half steps, legs 0 and 2 swing while 1 and 3 push, then the roles swap.
+void gaitSetTarget(int alpha, float stepLength, int gama, int spd, int halves);
+bool gaitQueueTarget(int alpha, float stepLength, int gama, int spd, int halves);
+u8 gaitQueueLength();
+bool gaitTick();
+void gaitFinishStride();
+bool isGaitActive();
+const GaitStats &getGaitStats();
+void clearGaitStats();
+
+#endif
@@ -0,0 +1,249 @@
+/**
+ * @file IKTable.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Optional inverse kinematics lookup table, trilinear interpolation over a grid of the foot workspace.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "IKTable.h"
+#include <atomic>
+
+#define NX IK_TABLE_NX
+#define NY IK_TABLE_NY
+#define NZ IK_TABLE_NZ
+#define IK_ENTRY_CLAMPED 0x8000 // Set in abc[0]: the point is beyond DR, cooToA() has a kink there so it is not interpolated.
+
+static const IKEntry *ikTable = NULL;
+static std::atomic<bool> isIKTableReady(false);	// Published with release once every entry is written.
+static std::atomic<bool> isIKTableBuilding(false);
+static volatile u8 ikMode = IK_MODE_ANALYTIC;
+static IKTableInfo ikInfo = {IK_TABLE_POINTS, IK_TABLE_POINTS * sizeof(IKEntry), 0, {0, 0, 0}, 0, 0};
+
+static inline u32 ikIndex(int i, int j, int k)
+{
+	return (i * NY + j) * NZ + k;
+}
+
+static bool ikInterpolate(const IKEntry *table, float x, float y, float z, float *abc)
+{
+	float fx = (x - IK_TABLE_X_MIN) * (1.0f / IK_TABLE_STEP);
+	float fy = (y - IK_TABLE_Y_MIN) * (1.0f / IK_TABLE_STEP);
+	float fz = (z - IK_TABLE_Z_MIN) * (1.0f / IK_TABLE_STEP);
+	if (!(fx >= 0 && fx < NX - 1 && fy >= 0 && fy < NY - 1 && fz >= 0 && fz < NZ - 1))
+	{
+		return false;
+	}
+	int i = fx, j = fy, k = fz;
+	fx -= i;
+	fy -= j;
+	fz -= k;
+	const IKEntry *e[8];
+	u16 flags = 0;
+	for (int n = 0; n < 8; n++)
+	{
+		e[n] = &table[ikIndex(i + (n >> 2), j + ((n >> 1) & 1), k + (n & 1))];
+		flags |= e[n]->abc[0];
+	}
+	if (flags & IK_ENTRY_CLAMPED)
+	{
+		return false;
+	}
+	for (int q = 0; q < 3; q++)
+	{
+		float v[8];
+		for (int n = 0; n < 8; n++)
+		{
+			v[n] = e[n]->abc[q];
+		}
+		float c00 = v[0] + (v[4] - v[0]) * fx, c01 = v[1] + (v[5] - v[1]) * fx;
+		float c10 = v[2] + (v[6] - v[2]) * fx, c11 = v[3] + (v[7] - v[3]) * fx;
+		float c0 = c00 + (c10 - c00) * fy, c1 = c01 + (c11 - c01) * fy;
+		abc[q] = (c0 + (c1 - c0) * fz) * (1.0f / IK_TABLE_SCALE);
+	}
+	return true;
+}
+
+/**
+ * @brief Sample cooToA() on the grid into table, then measure the interpolation error at every cell centre.
+ * The grid and the solver are fixed, so every fill gives the same table. cooToA() must solve analytically
+ * meanwhile: no table published, or IK_MODE_ANALYTIC.
+ */
+void ikTableFill(IKEntry *table, float *maxError)
+{
+	float abc[3];
+	for (int i = 0; i < NX; i++)
+	{
+		for (int j = 0; j < NY; j++)
+		{
+			for (int k = 0; k < NZ; k++)
+			{
+				float x = IK_TABLE_X_MIN + i * IK_TABLE_STEP, y = IK_TABLE_Y_MIN + j * IK_TABLE_STEP, z = IK_TABLE_Z_MIN + k * IK_TABLE_STEP;
+				cooToA(x, y, z, abc);
+				IKEntry &e = table[ikIndex(i, j, k)];
+				for (int q = 0; q < 3; q++)
+				{
+					e.abc[q] = lroundf(abc[q] * IK_TABLE_SCALE);
+				}
+				if (!isInActiveRadius(x, y, z))
+				{
+					e.abc[0] |= IK_ENTRY_CLAMPED;
+				}
+			}
+		}
+	}
+	maxError[0] = maxError[1] = maxError[2] = 0;
+	for (int i = 0; i < NX - 1; i++)
+	{
+		for (int j = 0; j < NY - 1; j++)
+		{
+			for (int k = 0; k < NZ - 1; k++)
+			{
+				float x = IK_TABLE_X_MIN + (i + 0.5f) * IK_TABLE_STEP, y = IK_TABLE_Y_MIN + (j + 0.5f) * IK_TABLE_STEP, z = IK_TABLE_Z_MIN + (k + 0.5f) * IK_TABLE_STEP;
+				float lut[3];
+				if (!ikInterpolate(table, x, y, z, lut))
+				{
+					continue;
+				}
+				cooToA(x, y, z, abc);
+				for (int q = 0; q < 3; q++)
+				{
+					maxError[q] = fmaxf(maxError[q], fabsf(lut[q] - abc[q]));
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Publish a table generated on the host, e.g. ik_table.bin embedded in the image. The entries are used
+ * in place, so data must stay valid. Entries that are not 2-byte aligned are copied to PSRAM first.
+ *
+ * @return false when the file does not match this grid, the table is then built on the device.
+ */
+bool ikTableLoad(const u8 *data, size_t size)
+{
+	IKTableFileHeader hdr;
+	if (data == NULL || size != sizeof(hdr) + IK_TABLE_POINTS * sizeof(IKEntry))
+	{
+		return false;
+	}
+	memcpy(&hdr, data, sizeof(hdr));
+	if (hdr.magic != IK_TABLE_MAGIC || hdr.xMin != IK_TABLE_X_MIN || hdr.xMax != IK_TABLE_X_MAX || hdr.yMin != IK_TABLE_Y_MIN ||
+		hdr.yMax != IK_TABLE_Y_MAX || hdr.zMin != IK_TABLE_Z_MIN || hdr.zMax != IK_TABLE_Z_MAX || hdr.step != IK_TABLE_STEP || hdr.scale != IK_TABLE_SCALE)
+	{
+		return false;
+	}
+	if (isIKTableBuilding.load() || isIKTableReady.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	const IKEntry *table = (const IKEntry *)(data + sizeof(hdr));
+	if (((uintptr_t)table & 1) != 0)
+	{
+		IKEntry *copy = (IKEntry *)heap_caps_malloc(ikInfo.bytes, MALLOC_CAP_SPIRAM);
+		if (copy == NULL)
+		{
+			return false;
+		}
+		memcpy(copy, table, ikInfo.bytes);
+		table = copy;
+	}
+	ikTable = table;
+	memcpy(ikInfo.maxError, hdr.maxError, sizeof(ikInfo.maxError));
+	ikInfo.buildMs = 0;
+	isIKTableReady.store(true, std::memory_order_release);
+	return true;
+}
+
+/**
+ * @brief Build the table into PSRAM on the device, when no generated table was loaded.
+ */
+bool ikTableBuild()
+{
+	IKEntry *table = (IKEntry *)heap_caps_malloc(ikInfo.bytes, MALLOC_CAP_SPIRAM);
+	if (table == NULL)
+	{
+		Serial.println("IK table: no PSRAM.");
+		return false;
+	}
+	u32 t0 = millis();
+	ikTableFill(table, ikInfo.maxError);
+	ikInfo.buildMs = millis() - t0;
+	ikTable = table;
+	isIKTableReady.store(true, std::memory_order_release);
+	Serial.printf("IK table: %lu points, %lu bytes, %lu ms, max error %.3f %.3f %.3f deg\n", (unsigned long)ikInfo.points, (unsigned long)ikInfo.bytes,
+				  (unsigned long)ikInfo.buildMs, ikInfo.maxError[0], ikInfo.maxError[1], ikInfo.maxError[2]);
+	return true;
+}
+
+/**
+ * @brief Answer one point from the table.
+ *
+ * @return false when the analytic solver must be used: IK_MODE_ANALYTIC, table not built, or point outside the grid.
+ */
+bool ikTableLookup(float x, float y, float z, float *a, float *b, float *c)
+{
+	if (ikMode != IK_MODE_TABLE || !isIKTableReady.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	float abc[3];
+	if (!ikInterpolate(ikTable, x, y, z, abc))
+	{
+		ikInfo.fallbacks++;
+		return false;
+	}
+	*a = abc[0];
+	*b = abc[1];
+	*c = abc[2];
+	ikInfo.lookups++;
+	return true;
+}
+
+// One-shot task: the build takes seconds, the command and motion tasks keep running meanwhile.
+static void task_IKTableBuild(void *pvParameters)
+{
+	if (ikTableBuild())
+	{
+		stepCacheInvalidate(); // Steps solved before the table was ready.
+	}
+	else
+	{
+		ikMode = IK_MODE_ANALYTIC;
+	}
+	isIKTableBuilding.store(false);
+	vTaskDelete(xTaskGetCurrentTaskHandle());
+}
+
+/**
+ * @brief Select the solver. IK_MODE_TABLE returns at once. Without a loaded table it is built on a
+ * background task the first time, and ikTableLookup() keeps answering false until it is ready.
+ */
+void setIKMode(u8 mode)
+{
+	stepCacheInvalidate(); // Table and solver angles differ slightly.
+	ikMode = mode == IK_MODE_TABLE ? IK_MODE_TABLE : IK_MODE_ANALYTIC;
+	if (ikMode == IK_MODE_TABLE && !isIKTableReady.load(std::memory_order_acquire) && !isIKTableBuilding.exchange(true))
+	{
+		// Priority 0, below every service task, on core 0 away from the motion task.
+		if (xTaskCreateUniversal(task_IKTableBuild, "task_IKTableBuild", 4096, NULL, 0, NULL, 0) != pdPASS)
+		{
+			isIKTableBuilding.store(false);
+			ikMode = IK_MODE_ANALYTIC;
+		}
+	}
+}
+
+u8 getIKMode()
+{
+	return ikMode;
+}
+
+const IKTableInfo &getIKTableInfo()
+{
+	return ikInfo;
+}
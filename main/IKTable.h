@@ -0,0 +1,73 @@
+/**
+ * @file IKTable.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Optional inverse kinematics lookup table, trilinear interpolation over a grid of the foot workspace.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _IKTABLE_h
+#define _IKTABLE_h
+
+#include "Public.h"
+
+#define IK_MODE_ANALYTIC	0	//cooToA() solves every point.
+#define IK_MODE_TABLE		1	//cooToA() interpolates the table, points outside it are solved.
+
+//Grid over the foot workspace in the leg frame, unit: mm. It covers calibratePosition,
+//BODY_HEIGHT_MIN~BODY_HEIGHT_MAX with the step lift, and the move_any() / twist_any() excursions.
+#define IK_TABLE_X_MIN		-64
+#define IK_TABLE_X_MAX		64
+#define IK_TABLE_Y_MIN		40
+#define IK_TABLE_Y_MAX		136
+#define IK_TABLE_Z_MIN		-56
+#define IK_TABLE_Z_MAX		56
+#define IK_TABLE_STEP		4
+#define IK_TABLE_SCALE		64	//Angles are stored in 1/64 degree.
+#define IK_TABLE_NX			((IK_TABLE_X_MAX - IK_TABLE_X_MIN) / IK_TABLE_STEP + 1)
+#define IK_TABLE_NY			((IK_TABLE_Y_MAX - IK_TABLE_Y_MIN) / IK_TABLE_STEP + 1)
+#define IK_TABLE_NZ			((IK_TABLE_Z_MAX - IK_TABLE_Z_MIN) / IK_TABLE_STEP + 1)
+#define IK_TABLE_POINTS		(IK_TABLE_NX * IK_TABLE_NY * IK_TABLE_NZ)
+#define IK_TABLE_MAGIC		0x31544B49	//"IKT1"
+
+//One grid point, x major then y then z. Unit: 1 / IK_TABLE_SCALE degree.
+struct IKEntry
+{
+	u16 abc[3];
+};
+
+//ik_table.bin: this header, then IK_TABLE_POINTS entries, little-endian. Generated on the host by
+//test/host IKTableGen and embedded in the firmware image, a grid that differs from the one above is refused.
+//Fixed width fields: u32 is unsigned long, 8 bytes on a 64-bit host.
+struct IKTableFileHeader
+{
+	uint32_t magic;
+	int16_t xMin, xMax, yMin, yMax, zMin, zMax;
+	u16 step, scale;
+	float maxError[3];
+};
+static_assert(sizeof(IKTableFileHeader) == 32, "ik_table.bin layout");
+static_assert(sizeof(IKEntry) == 6, "ik_table.bin layout");
+
+struct IKTableInfo
+{
+	u32 points;			//Grid points.
+	u32 bytes;			//Table size, in flash when loaded from ik_table.bin, else in PSRAM.
+	u32 buildMs;		//0 when loaded.
+	float maxError[3];	//Largest |table - cooToA()| of a, b, c over all cell centres, unit: degree.
+	u32 lookups;		//Points answered by the table.
+	u32 fallbacks;		//Points solved analytically in IK_MODE_TABLE.
+};
+
+void ikTableFill(IKEntry *table, float *maxError);
+bool ikTableLoad(const u8 *data, size_t size);
+bool ikTableBuild();
+bool ikTableLookup(float x, float y, float z, float *a, float *b, float *c);
+void setIKMode(u8 mode);
+u8 getIKMode();
+const IKTableInfo &getIKTableInfo();
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file LegTopology.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Wiring of the leg servos to the PCA9685 channels, fixed at compile time.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _LEGTOPOLOGY_h
+#define _LEGTOPOLOGY_h
+
+#include "Public.h"
+
+#define LEG_JOINTS		12	//4 legs, servos a, b, c.
+
+struct JointWiring
+{
+	u8 channel;			//PCA9685 channel.
+	bool isMirrored;	//The servo turns the other way, horn = 180 - (angle + offset).
+};
+
+struct LegTopology
+{
+	JointWiring joint[4][3];
+};
+
+//legs index: 0: Left front, 1: Left rear, 2: Right rear, 3: Right front.
+//A robot wired another way only needs another descriptor here.
+constexpr LegTopology legTopology = {{{{0, false}, {1, false}, {2, false}},
+									  {{7, false}, {6, false}, {5, false}},
+									  {{8, false}, {9, true}, {10, true}},
+									  {{15, false}, {14, true}, {13, true}}}};
+
+constexpr u8 legChannel(int n)
+{
+	return legTopology.joint[n / 3][n % 3].channel;
+}
+
+//Channels of joints 0~N-1 as a mask, a frame written by the leg writers carries LegMask<LEG_JOINTS>::value.
+template <int N>
+struct LegMask
+{
+	static constexpr u16 value = LegMask<N - 1>::value | 1 << legChannel(N - 1);
+};
+
+template <>
+struct LegMask<0>
+{
+	static constexpr u16 value = 0;
+};
+
+#endif
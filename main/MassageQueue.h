@@ -18,184 +18,127 @@
 #else
 #include "WProgram.h"
 #endif
-
-// constexpr auto queue_size = 3;
-
-//The head points to the first position in the queue, which is the position to be dequeued.
-//The tail points to the last position +1 in the queue, here is a null value, the position to enqueue.
-//When the queue is empty, head=tail.
-//When the queue is full, head = tail + 1, leaving an empty position.
-//The maximum storage number of the queue is SIZE-1, otherwise when empty and full, the head is equal to the tail.
-
-template <typename T>
-class DataQueue
+#include <stdarg.h>
+#include "MessagePool.h"
+
+//Text messages between tasks. The text sits in a MessagePool block and the ring carries its handle,
+//any task may enter and take, nothing is allocated on the heap. The taker frees the block.
+//When the queue is full enter() drops the new message, enterForced() the oldest one. Both are counted.
+template <uint32_t N>
+class MessageQueue
 {
-
 private:
-	// String values[queue_size];
-	uint16_t queue_size;
-	T *values;
-	uint16_t head;
-	uint16_t tail;
-	T maxVal;
-	T minVal;
-	bool enableMaxMin;
-
-	void calculateMaxMin();
+	MpmcRing<MessageHandle, N> ring;
+	std::atomic<uint32_t> dropped, highWater;
 
 public:
-	// MassageQueue();
-	DataQueue(int queueSize = 3, bool _enableMaxMin = false);
-	~DataQueue();
-	bool enter(T val);
-	//Force to enqueue. When the queue is full, the dequeue will be executed first, and then normally enqueue.
-	bool enterForced(T val);
-	T out();
-	bool isEmpty();
-	bool isFull();
-	uint16_t length();
-	T getValue(uint16_t n);
-	T getMax();
-	T getMin();
-	void setEnableMaxMin(bool _enableMaxMin = false);
-};
+	MessageQueue() : dropped(0), highWater(0) {}
 
-template <typename T>
-inline void DataQueue<T>::calculateMaxMin()
-{
-	if (enableMaxMin)
+	bool enter(MessageHandle h)
 	{
-		T val;
-		maxVal = T('\0');
-		minVal = T(0xFFFFFFFF);
-		for (int i = 0; i < length(); i++)
+		if (!ring.push(h))
 		{
-			val = values[(head + i) % queue_size];
-			maxVal = val > maxVal ? val : maxVal;
-			minVal = val < minVal ? val : minVal;
+			messageFree(h);
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
 		}
+		messageRaiseHighWater(highWater, ring.length());
+		return true;
 	}
-}
 
-template <typename T>
-DataQueue<T>::DataQueue(int queueSize, bool _enableMaxMin)
-{
-	enableMaxMin = _enableMaxMin;
-	queue_size = queueSize;
-	values = new T[queue_size];
-	head = 0;
-	tail = 0;
-}
-template <typename T>
-inline DataQueue<T>::~DataQueue()
-{
-	delete values;
-}
-template <typename T>
-bool DataQueue<T>::enter(T val)
-{
-	if (!isFull())
+	//Telemetry, where the latest reading matters: when the queue is full, the oldest message is taken
+	//and freed first. Bounded, if other producers fill the freed slot again the new message is dropped.
+	bool enterForced(MessageHandle h)
 	{
-		values[tail] = val;
-		tail = (tail + 1) % queue_size;
-		calculateMaxMin();
-		return true;
+		MessageHandle old;
+		if (ring.push(h))
+		{
+			messageRaiseHighWater(highWater, ring.length());
+			return true;
+		}
+		if (ring.pop(old))
+		{
+			messageFree(old);
+			dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+		return enter(h);
 	}
-	return false;
-}
 
-template <typename T>
-bool DataQueue<T>::enterForced(T val)
-{
-	if (!enter(val))
+	bool enter(const char *text)
 	{
-		out();
-		return enter(val);
+		MessageHandle h;
+		if (!messageAlloc(h))
+		{
+			return false;
+		}
+		snprintf(messageText(h), MESSAGE_BLOCK_SIZE, "%s", text);
+		return enter(h);
 	}
-	else
+
+	//Format straight into a block, as printf().
+	bool printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
 	{
-		return true;
+		MessageHandle h;
+		if (!messageAlloc(h))
+		{
+			return false;
+		}
+		va_list args;
+		va_start(args, format);
+		vsnprintf(messageText(h), MESSAGE_BLOCK_SIZE, format, args);
+		va_end(args);
+		return enter(h);
 	}
-}
 
-template <typename T>
-inline T DataQueue<T>::out()
-{
-	T res = T(0);
-	if (!isEmpty())
+	//printf() for telemetry, as enterForced(). With the pool exhausted the block of the oldest message is reused.
+	bool printfForced(const char *format, ...) __attribute__((format(printf, 2, 3)))
 	{
-		res = values[head];
-		values[head] = T('\0');
-		head = (head + 1) % queue_size;
-		calculateMaxMin();
+		MessageHandle h;
+		if (!messageAlloc(h))
+		{
+			if (!ring.pop(h))
+			{
+				return false;
+			}
+			dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+		va_list args;
+		va_start(args, format);
+		vsnprintf(messageText(h), MESSAGE_BLOCK_SIZE, format, args);
+		va_end(args);
+		return enterForced(h);
 	}
-	return res;
-}
 
-template <typename T>
-bool DataQueue<T>::isEmpty()
-{
-	if (head == tail)
+	bool out(MessageHandle &h)
 	{
-		// Serial.println("MassageQueue is empty!");
-		return true;
+		return ring.pop(h);
 	}
-	else
+
+	bool isEmpty() const
 	{
-		return false;
+		return ring.isEmpty();
 	}
-}
 
-template <typename T>
-bool DataQueue<T>::isFull()
-{
-	if ((tail + 1) % queue_size == head)
+	uint32_t length() const
 	{
-		// Serial.println("MassageQueue is full, can not enter more msg!");
-		return true;
+		return ring.length();
 	}
-	else
+
+	uint32_t getDropped() const
 	{
-		return false;
+		return dropped.load(std::memory_order_relaxed);
 	}
-}
 
-template <typename T>
-uint16_t DataQueue<T>::length()
-{
-	int len = tail - head;
-	return len >= 0 ? len : len + queue_size;
-}
-
-template <typename T>
-inline T DataQueue<T>::getValue(uint16_t n)
-{
-	if (n < length())
+	uint32_t getHighWater() const
 	{
-		return values[(head + n) % queue_size];
+		return highWater.load(std::memory_order_relaxed);
 	}
-	else
+
+	void clearStats()
 	{
-		return T('\0');
+		dropped.store(0, std::memory_order_relaxed);
+		highWater.store(ring.length(), std::memory_order_relaxed);
 	}
-}
-
-template <typename T>
-inline T DataQueue<T>::getMax()
-{
-	return maxVal;
-}
-
-template <typename T>
-inline T DataQueue<T>::getMin()
-{
-	return minVal;
-}
-
-template <typename T>
-inline void DataQueue<T>::setEnableMaxMin(bool _enableMaxMin)
-{
-	enableMaxMin = _enableMaxMin;
-}
+};
 
 #endif
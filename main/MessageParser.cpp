@@ -13,49 +13,70 @@
 
 MessageParser::MessageParser()
 {
+	clearParameters();
 }
 
-void MessageParser::parser(String msg)
+/**
+ * @brief Split "C#p1#p2#...#" in one pass over a copy in the parser buffer, without allocating.
+ * The incoming command parameter ends with a # sign, otherwise the last one will not be recognized.
+ * A parameter is the leading integer of its field, as String::toInt().
+ */
+void MessageParser::parser(const char *msg, size_t length)
 {
 	clearParameters();
-	//Serial.print("mqMotion.length : ");
-	//Serial.print(mqMotion.length());
-	inputStringTemp = msg; //mqMotion.out();
-	//Serial.print(" inputStringTemp : ");
-	//Serial.println(inputStringTemp);
-	for (u8 i = 0; i < COMMANDS_COUNT_MAX; i++)
-	{ //The incoming command parameter ends with a # sign, otherwise the last one will not be recognized.
-		int index = inputStringTemp.indexOf(INTERVAL_CHAR);
-		//Serial.println(index);
-		if (index < 0)
+	length = length < MESSAGE_LENGTH_MAX ? length : MESSAGE_LENGTH_MAX;
+	memcpy(buffer, msg, length);
+	buffer[length] = '\0';
+
+	u8 n = 0;
+	char *start = buffer;
+	int value = 0, sign = 1;
+	bool isNumber = true;
+	for (char *p = buffer; p < buffer + length && n < COMMANDS_COUNT_MAX; p++)
+	{
+		char c = *p;
+		if (c == INTERVAL_CHAR)
+		{
+			*p = '\0';
+			fields[n].data = start;
+			fields[n].length = p - start;
+			paramters[n] = sign * value;
+			paramterCount = n;
+			n++;
+			start = p + 1;
+			value = 0;
+			sign = 1;
+			isNumber = true;
+		}
+		else if (isNumber && c >= '0' && c <= '9')
+		{
+			value = value * 10 + (c - '0');
+		}
+		else if (isNumber && p == start && (c == '-' || c == '+'))
+		{
+			sign = c == '-' ? -1 : 1;
+		}
+		else
 		{
-			break;
+			isNumber = false;
 		}
-		paramterCount = i; //
-		inputCommandArray[i] = inputStringTemp.substring(0, index);
-		inputStringTemp = inputStringTemp.substring(index + 1);
-		paramters[i] = inputCommandArray[i].toInt();
 	}
-	//Serial.print(inputCommandArray[0]);
-	//Serial.print(" , paramterCount : ");
-	//Serial.println(paramterCount);
-	//Serial.println(String(paramters[1]) + String(" ") + String(paramters[2]) + String(" ") + String(paramters[3]));
-	commandChar = inputCommandArray[0].charAt(0);
-	isNewMessage = true;
+	commandChar = fields[0].data[0];
+}
+
+void MessageParser::parser(const String &msg)
+{
+	parser(msg.c_str(), msg.length());
 }
 
 void MessageParser::clearParameters()
 {
-	//Serial.print(isNewMessage);
-	if (isNewMessage)
-	{
-		isNewMessage = false;
-		commandChar = 0;
-		//Serial.println("Clear paramters 2 ");
-		for (int i = 0; i < COMMANDS_COUNT_MAX; i++)
-		{ //Clear parameter table.
-			inputCommandArray[i] = "";
-			paramters[i] = 0;
-		}
+	commandChar = 0;
+	paramterCount = 0;
+	for (int i = 0; i < COMMANDS_COUNT_MAX; i++)
+	{ //Clear parameter table.
+		fields[i].data = "";
+		fields[i].length = 0;
+		paramters[i] = 0;
 	}
 }
@@ -20,26 +20,32 @@
 
 #define COMMANDS_COUNT_MAX 8		//The maximum size of the command + parameter contained in the message.
 #define INTERVAL_CHAR '#'
+#define MESSAGE_LENGTH_MAX 128		//Longer messages are cut, the fields after the cut are lost.
 
 typedef unsigned char u8;
 typedef unsigned short u16;
 typedef unsigned long u32;
 
+//One field of the last message, a slice of the parser buffer. The '#' is replaced by '\0', so data is also a C string.
+struct MessageField
+{
+	const char *data;
+	u8 length;
+};
+
 class MessageParser
 {
 private:
+	char buffer[MESSAGE_LENGTH_MAX + 1];
 
-
-	
 public:
-	String inputStringTemp = "";
-	String inputCommandArray[COMMANDS_COUNT_MAX];
+	MessageField fields[COMMANDS_COUNT_MAX];
 	int paramters[COMMANDS_COUNT_MAX], paramterCount = 0; //The number of parameters not including the command word.
 	char commandChar;
-	bool isNewMessage = true;
 
 	MessageParser();
-	void parser(String msg);
+	void parser(const char *msg, size_t length);
+	void parser(const String &msg);
 	void clearParameters();
 };
 
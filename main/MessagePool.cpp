@@ -0,0 +1,65 @@
+/**
+ * @file MessagePool.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Fixed blocks in internal RAM for the text messages between tasks. Queues pass block handles.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "MessagePool.h"
+
+static char blocks[MESSAGE_POOL_BLOCKS][MESSAGE_BLOCK_SIZE]; // .bss, internal RAM.
+
+// The free blocks are themselves a lock-free ring of handles, any task may allocate or free.
+static struct FreeBlocks
+{
+	MpmcRing<MessageHandle, MESSAGE_POOL_BLOCKS> ring;
+	FreeBlocks()
+	{
+		for (u32 i = 0; i < MESSAGE_POOL_BLOCKS; i++)
+		{
+			ring.push(i);
+		}
+	}
+} freeBlocks;
+
+static std::atomic<uint32_t> inUse(0), highWater(0), exhausted(0);
+
+bool messageAlloc(MessageHandle &h)
+{
+	if (!freeBlocks.ring.pop(h))
+	{
+		exhausted.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	messageRaiseHighWater(highWater, inUse.fetch_add(1, std::memory_order_relaxed) + 1);
+	blocks[h][0] = '\0';
+	return true;
+}
+
+void messageFree(MessageHandle h)
+{
+	inUse.fetch_sub(1, std::memory_order_relaxed);
+	freeBlocks.ring.push(h);
+}
+
+char *messageText(MessageHandle h)
+{
+	return blocks[h];
+}
+
+void getMessagePoolStats(MessagePoolStats &st)
+{
+	st.inUse = inUse.load(std::memory_order_relaxed);
+	st.highWater = highWater.load(std::memory_order_relaxed);
+	st.exhausted = exhausted.load(std::memory_order_relaxed);
+}
+
+void clearMessagePoolStats()
+{
+	highWater.store(inUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	exhausted.store(0, std::memory_order_relaxed);
+}
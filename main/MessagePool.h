@@ -0,0 +1,48 @@
+/**
+ * @file MessagePool.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Fixed blocks in internal RAM for the text messages between tasks. Queues pass block handles.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _MESSAGEPOOL_h
+#define _MESSAGEPOOL_h
+
+#include <atomic>
+#include "MessageParser.h"
+#include "MpmcRing.h"
+
+#define MESSAGE_BLOCK_SIZE	128		//Bytes per block, a message is cut to MESSAGE_BLOCK_SIZE - 1 characters.
+#define MESSAGE_POOL_BLOCKS	64		//Power of two, shared by all message queues.
+
+typedef u8 MessageHandle;
+
+static_assert(MESSAGE_POOL_BLOCKS <= 256, "MessageHandle is one byte");
+
+struct MessagePoolStats
+{
+	u32 inUse;			//Blocks allocated now.
+	u32 highWater;		//Most blocks allocated at once.
+	u32 exhausted;		//Allocations refused because every block was in use.
+};
+
+bool messageAlloc(MessageHandle &h);
+void messageFree(MessageHandle h);
+char *messageText(MessageHandle h);
+void getMessagePoolStats(MessagePoolStats &st);
+void clearMessagePoolStats();
+
+//Raise a high-water mark shared between tasks.
+static inline void messageRaiseHighWater(std::atomic<uint32_t> &highWater, uint32_t value)
+{
+	uint32_t old = highWater.load(std::memory_order_relaxed);
+	while (value > old && !highWater.compare_exchange_weak(old, value, std::memory_order_relaxed))
+	{
+	}
+}
+
+#endif
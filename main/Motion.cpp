@@ -11,8 +11,6 @@
 
 #include "Motion.h"
 
-#define TICK_MS 10 //The time length of each tick, the unit is ms, and the coordinate point is updated every tick.
-#define STEP_HEIGHT 15
 // define leg length (hauteur d'un pas)
 // L1: Root
 #define L1 23.0
@@ -22,13 +20,8 @@
 #define L3 59.0
 // Define active radius, DR = L2+L3-10 (rayon actif défini) 
 #define DR 100.0 // (104 ?)
-
-/**
- * @brief define the body length and width , between adjacent servo.
- * @LEN_BD: body length / 2 = 136.4 / 2.
- * @WID_BD: body width / 2 = 80 / 2.
- */
-constexpr float LEN_BD = 68.2, WID_BD = 40;
+// Minimum reach: the calf folded back onto the thigh, L3 - L2.
+#define DR_MIN 4.0
 
 /**
  * @brief define the hypotenuse
@@ -42,9 +35,6 @@ constexpr float v = sqrt(square(LEN_BD) + square(WID_BD));
  */
 constexpr float theta = atan(WID_BD / LEN_BD);
 
-// The movement speed of the leg end point. Too fast speed will damage the servo. Unit: x mm / 10ms
-#define SPEED_MIN 1
-#define SPEED_MAX 8
 int moveSpeed = 5;
 
 // Height
@@ -120,7 +110,8 @@ void move_leg_to_point_directly(float (*startPt)[3], float (*end__Pt)[3])
 			// d = 2;
 		}
 		// First move leg 0 and 2. Then move leg 1 and 3. // 
-		for (int t = 0; t <= stepTicks; t++)
+		motionClockStart();
+		for (int t = 0; t <= stepTicks; t = motionTick(t, stepTicks))
 		{
 			for (int j = 0; j < 4; j++) //
 			{	// on met à jour les TrackPt des 4 pattes 
@@ -142,9 +133,10 @@ void move_leg_to_point_directly(float (*startPt)[3], float (*end__Pt)[3])
 			// cooToA recalcule donc les angles des servos pour aller à la nouvelle position sans avoir [PxM1;PxP] > DR
 			cooToA(trackPt[a], las[a]); //trackPt[a] position PaP (xyz), las[a] angles moteurs Pa
 			cooToA(trackPt[c], las[c]);
+			servoOutputBeginFrame();
 			updateLegx(a); // Update commande servos avec les noueaux angles
 			updateLegx(c);
-			delay(TICK_MS); // délai ajouté entre les mouvements des servos (10ms)
+			servoOutputCommitFrame(); // Both legs in one frame.
 		}
 	}
 	for (int j = 0; j < 4; j++) // on maj la position finale des 4 pattes avec le point obtenu en sortie de la boucle de déplacement
@@ -152,6 +144,7 @@ void move_leg_to_point_directly(float (*startPt)[3], float (*end__Pt)[3])
 		lastPt[j][0] = trackPt[j][0];
 		lastPt[j][1] = trackPt[j][1];
 		lastPt[j][2] = trackPt[j][2];
+		clampFootPoint(lastPt[j]); // Where the foot really is.
 		// Serial.println(">>>>>");
 		// Serial.println(String("lastPt: ") + String(lastPt[j][0]) + String(" ") + String(lastPt[j][1]) + String(" ") + String(lastPt[j][2]));
 		// Serial.println("<<<<<");
@@ -272,7 +265,8 @@ void move_step_by_step(float (*startPt)[3], float (*end__Pt)[3], int spd)
 		// }
 		// Serial.println("<----<");
 
-		for (int t = 0; t <= stepTicks; t++)
+		motionClockStart();
+		for (int t = 0; t <= stepTicks; t = motionTick(t, stepTicks))
 		{
 			//First calculate the X-axis coordinates of the four points, of which leg 0 and 2 (rôle A) moves forward, and 1 3 and 0 2 move relatively.
 			trackPt[a][0] = startPt[a][0] + (end__Pt[a][0] - startPt[a][0]) * t / stepTicks; //
@@ -304,7 +298,6 @@ void move_step_by_step(float (*startPt)[3], float (*end__Pt)[3], int spd)
 			trackPt[d][2] = startPt[d][2] + (end__Pt[d][2] - startPt[d][2]) * t / stepTicks; // Legs 2 and 3 are reversed to each other.
 			cooToA_All(trackPt, las); // normalise la position des pattes
 			updateServoAngle(); // MAJ la commande des servos (4 pattes)
-			delay(TICK_MS); // délai entre deux mouvements
 			// for (int j = 0; j < 4; j++) {
 			//	Serial.println(String("trackPt: ") + String(trackPt[j][0]) + String(" ") + String(trackPt[j][1]) + String(" ") + String(trackPt[j][2]));
 			// }
@@ -337,6 +330,7 @@ void move_step_by_step(float (*startPt)[3], float (*end__Pt)[3], int spd)
 		lastPt[j][0] = trackPt[j][0]; // on remet toutes les coordonnées des pattes à jour (déjà fait plus haut , semble redondant)
 		lastPt[j][1] = trackPt[j][1];
 		lastPt[j][2] = trackPt[j][2];
+		clampFootPoint(lastPt[j]); // Where the foot really is.
 		// Serial.println(String("lastPt: ") + String(lastPt[j][0]) + String(" ") + String(lastPt[j][1]) + String(" ") + String(lastPt[j][2]));
 	}
 	// Serial.println("<<<<<");
@@ -347,7 +341,7 @@ void move_step_by_step(float (*startPt)[3], float (*end__Pt)[3], int spd)
 // alpha is the moving direction, with the x-axis direction as 0 degrees, counterclockwise as positive, clockwise as negative. The unit is radians.
 // StepLength is step distance.
 /**
- * @brief Walk command, any direction, any step length, any spin angle, any speed
+ * @brief Stride target of a walk command, any direction, any step length, any spin angle. Also sets movingOriginPos.
  *
  * @param alpha is the moving direction, with the x-axis direction as 0 degrees, counterclockwise as positive, clockwise as negative, and the unit is angle, [0-360]. The x direction is the direction of forward movement.
  // alpha direction du mouvement linéaire (translation): (dans le plan XZ)
@@ -356,18 +350,17 @@ void move_step_by_step(float (*startPt)[3], float (*end__Pt)[3], int spd)
  * @param gama Spin angle, in-situ rotation, positive counterclockwise, negative clockwise, in degrees. [0-360].
  * // Angle de rotation (dégré) joystick droit de la commande ? --> positif dans le sens horaire (tourne autour de l'axe x ? dans le plan de THETA)
    // mvmt rotation pure --> le centre de gravité ne bouge pas
- * @param spd Movement speed, unit：mm / 10ms.  [1,8]
+ * @param newPt End point of every leg after the stride.
  */
-void move_any(int alpha, float stepLength, int gama, int spd) 
+void getStepTarget(float alpha, float stepLength, float gama, float (*newPt)[3])
 	// l'argument alpha est un angle en degrés (direction du déplacement linéaire [TRANSLATION]) --> Joystick gauche angle
 	// l'agument stepLength semble être la longueur d'un pas [TRANSLATION] --> Joystick droit profondeur
 	// l'argument gama correspond au spin [ROTATION]--> joystick droit angle
 {
 	stepLength /= 2; // stepLength = stepLength/2
-	float newPt[4][3];
 	float delta_x, delta_z;
-	delta_x = stepLength * cos(alpha * PI / 180); //Portrait : projection du pas selon l'axe X (on met alpha en radians) [TRANSLATION]
-	delta_z = stepLength * sin(alpha * PI / 180); //Horizontal : projection du pas selon l'axe Z (on met alpha en radians) [TRANSLATION]
+	delta_x = stepLength * fastCosDeg(alpha); //Portrait : projection du pas selon l'axe X (on met alpha en radians) [TRANSLATION]
+	delta_z = stepLength * fastSinDeg(alpha); //Horizontal : projection du pas selon l'axe Z (on met alpha en radians) [TRANSLATION]
 	float pt[] = {delta_x, 0, delta_z};			  //Target body coordinates. After each action ends, the body coordinates are regarded as the origin.
 	// Coordonnées du corps cible (centre de gravité (repère XYZ)). À la fin de chaque action, les coordonnées du corps sont considérées comme l'origine.
 
@@ -397,11 +390,11 @@ void move_any(int alpha, float stepLength, int gama, int spd)
 	movingOriginPos[3][1] = calibratePosition[3][1] - delta_x * kx_p + delta_z * kz_p; 
 
 	// rotation
-	float c = gama * PI / 180; // c = gama angle de spin en radian
-	float v_x_sin_theta_p_c = v * sin(theta + c); // spin des pattes Px et Pxo projeté sur Xx et Xx+2
-	float v_x_sin_theta_m_c = v * sin(theta - c); // mouvement inverse avec les pattes opposé pour que ca tourne
-	float v_x_cos_theta_p_c = v * cos(theta + c); // spin des pattes Px+1 et Pxo+1 projeté sur Zx+1 et Zx+3
-	float v_x_cos_theta_m_c = v * cos(theta - c); // mouvement inverse avec les pattes opposé pour que ca tourne
+	float c = gama * FAST_DEG_TO_RAD; // c = gama angle de spin en radian
+	float v_x_sin_theta_p_c = v * fastSin(theta + c); // spin des pattes Px et Pxo projeté sur Xx et Xx+2
+	float v_x_sin_theta_m_c = v * fastSin(theta - c); // mouvement inverse avec les pattes opposé pour que ca tourne
+	float v_x_cos_theta_p_c = v * fastCos(theta + c); // spin des pattes Px+1 et Pxo+1 projeté sur Zx+1 et Zx+3
+	float v_x_cos_theta_m_c = v * fastCos(theta - c); // mouvement inverse avec les pattes opposé pour que ca tourne
 
 	// Position finale : translation + rotation (projeté sur Xn)
 	newPt[0][0] = movingOriginPos[0][0] + pt[0] + v_x_cos_theta_p_c - LEN_BD;
@@ -421,11 +414,28 @@ void move_any(int alpha, float stepLength, int gama, int spd)
 	newPt[2][2] = movingOriginPos[2][2] + pt[2] - v_x_sin_theta_p_c + WID_BD;
 	newPt[3][2] = movingOriginPos[3][2] + pt[2] - v_x_sin_theta_m_c + WID_BD;
 
-	move_step_by_step(lastPt, newPt, spd);
-
 	// memcpy(calibratePosition, tmpCalibrationPos, sizeof(calibratePosition));
 }
 
+/**
+ * @brief Walk command: one stride of the gait engine, legs 0 and 2 then legs 1 and 3.
+ * Returns once the stride is running, so the next move_any() is queued behind it and the strides
+ * join without stopping. gaitFinishStride() waits for the last one.
+ *
+ * @param alpha, stepLength, gama See getStepTarget().
+ * @param spd Movement speed, unit：mm / 10ms.  [1,8]
+ */
+void move_any(int alpha, float stepLength, int gama, int spd)
+{
+	while (!gaitQueueTarget(alpha, stepLength, gama, spd, 2))
+	{
+		gaitTick();
+	}
+	while (gaitQueueLength() > 0 && gaitTick())
+	{
+	}
+}
+
 /**
  * @brief //Twist the body without moving the body.
  *
@@ -449,7 +459,8 @@ void action_twist(float (*startPt)[3], float (*end__Pt)[3], float tickLength, bo
 	}
 	int stepTicks = round(lenghtP2P / tickLength) + 2; // plus grand déplacement d'une patte / tickLength +2 (stepTicks = temps donc tickLength devrait correspondre à une vitesse)
 	//The four legs move together starting from the calibration position.
-	for (int t = 0; t <= stepTicks; t++)
+	motionClockStart();
+	for (int t = 0; t <= stepTicks; t = motionTick(t, stepTicks))
 	{
 		for (int j = 0; j < 4; j++)
 		{
@@ -465,7 +476,6 @@ void action_twist(float (*startPt)[3], float (*end__Pt)[3], float tickLength, bo
 		}
 		cooToA_All(trackPt, las); // calcule la position normalisée (limiter distance PxM1 PxP)
 		updateServoAngle(isContainedOffset); // maj de la commande des servos (arg = avec ou sans offset)
-		vTaskDelay(TICK_MS);
 	}
 
 	for (int j = 0; j < 4; j++)
@@ -473,6 +483,7 @@ void action_twist(float (*startPt)[3], float (*end__Pt)[3], float tickLength, bo
 		lastPt[j][0] = trackPt[j][0];
 		lastPt[j][1] = trackPt[j][1];
 		lastPt[j][2] = trackPt[j][2];
+		clampFootPoint(lastPt[j]); // Where the foot really is.
 		// Serial.println(">>>>>");
 		// Serial.println(String("lastPt: ") + String(lastPt[j][0]) + String(" ") + String(lastPt[j][1]) + String(" ") + String(lastPt[j][2]));
 		// Serial.println("<<<<<");
@@ -481,17 +492,17 @@ void action_twist(float (*startPt)[3], float (*end__Pt)[3], float tickLength, bo
 
 void twist_any(int alpha, int beta, int gama)
 {
-	float a = alpha * PI / 180;
-	float b = beta * PI / 180;
-	float c = gama * PI / 180;
+	float a = alpha * FAST_DEG_TO_RAD;
+	float b = beta * FAST_DEG_TO_RAD;
+	float c = gama * FAST_DEG_TO_RAD;
 
-	float v_x_sin_theta_p_c = v * sin(theta + c);
-	float v_x_sin_theta_m_c = v * sin(theta - c);
-	float v_x_cos_theta_p_c = v * cos(theta + c);
-	float v_x_cos_theta_m_c = v * cos(theta - c);
+	float v_x_sin_theta_p_c = v * fastSin(theta + c);
+	float v_x_sin_theta_m_c = v * fastSin(theta - c);
+	float v_x_cos_theta_p_c = v * fastCos(theta + c);
+	float v_x_cos_theta_m_c = v * fastCos(theta - c);
 
-	float l_x_sin_a = LEN_BD * sin(a);
-	float w_x_sin_b = WID_BD * sin(b);
+	float l_x_sin_a = LEN_BD * fastSin(a);
+	float w_x_sin_b = WID_BD * fastSin(b);
 
 	float newPt[4][3];
 
@@ -563,10 +574,12 @@ void setBeforeCalibrationHeight(int h)
 
 void setServoToInstallationPosition()
 {
+	servoOutputBeginFrame();
 	for (int i = 0; i < 16; i++)
 	{
-		pca.setServoAngle(i, 90);
+		servoOutputSetAngle(i, 90);
 	}
+	servoOutputCommitFrame();
 }
 void setServoToBeforeCalibrationPosition()
 {
@@ -588,9 +601,10 @@ void moveOneLegToPointDirectly(uint8_t n, bool b, float(*startPt), float(*end__P
 	//Calculate the required motion periods, ticks.
 	int stepTicks = round(lenghtP2P / 5) + 2;
 	// Serial.println(String("stepTicks: ") + String(stepTicks));
-	float trackPt[3];
+	float trackPt[3] = {startPt[0], startPt[1], startPt[2]};
 	//Move according to the track
-	for (int t = 0; t <= stepTicks; t++)
+	motionClockStart();
+	for (int t = 0; t <= stepTicks; t = motionTick(t, stepTicks))
 	{
 		for (int j = 0; j < 3; j++)
 		{
@@ -598,7 +612,6 @@ void moveOneLegToPointDirectly(uint8_t n, bool b, float(*startPt), float(*end__P
 		}
 		cooToA(trackPt, las[n]);
 		b ? updateLegx(n) : updateLegxWithoutOffset(n);
-		delay(TICK_MS);
 	}
 	//Record end point position.
 	for (int j = 0; j < 3; j++)
@@ -608,6 +621,7 @@ void moveOneLegToPointDirectly(uint8_t n, bool b, float(*startPt), float(*end__P
 		// Serial.println(String("lastPt: ") + String(lastPt[j][0]) + String(" ") + String(lastPt[j][1]) + String(" ") + String(lastPt[j][2]));
 		// Serial.println("<<<<<");
 	}
+	clampFootPoint(lastPt[n]);
 }
 
 void moveAllLegToPointDirectly(bool b, float (*startPt)[3], float (*end__Pt)[3])
@@ -621,8 +635,10 @@ void moveAllLegToPointDirectly(bool b, float (*startPt)[3], float (*end__Pt)[3])
 	int stepTicks = round(lenghtP2P / 5) + 2;
 
 	float trackPt[4][3];
+	memcpy(trackPt, startPt, sizeof(trackPt));
 
-	for (int t = 0; t <= stepTicks; t++)
+	motionClockStart();
+	for (int t = 0; t <= stepTicks; t = motionTick(t, stepTicks))
 	{
 		for (int j = 0; j < 4; j++)
 		{
@@ -632,14 +648,14 @@ void moveAllLegToPointDirectly(bool b, float (*startPt)[3], float (*end__Pt)[3])
 			}
 		}
 		cooToA_All(trackPt, las);
-		updateServoAngle();
-		delay(TICK_MS);
+		updateServoAngle(b);
 	}
 	for (int j = 0; j < 4; j++)
 	{
 		lastPt[j][0] = trackPt[j][0];
 		lastPt[j][1] = trackPt[j][1];
 		lastPt[j][2] = trackPt[j][2];
+		clampFootPoint(lastPt[j]); // Where the foot really is.
 		// Serial.println(">>>>>");
 		// Serial.println(String("lastPt: ") + String(lastPt[j][0]) + String(" ") + String(lastPt[j][1]) + String(" ") + String(lastPt[j][2]));
 		// Serial.println("<<<<<");
@@ -648,161 +664,141 @@ void moveAllLegToPointDirectly(bool b, float (*startPt)[3], float (*end__Pt)[3])
 
 void updateLegx(u8 x)
 {
-	switch (x)
+	servoOutputBeginFrame();
+	for (u8 j = 0; j < 3; j++)
 	{
-	case 0:
-		pca.setServoAngle(0, las[0][0] + servoOffset[0][0]);
-		pca.setServoAngle(1, las[0][1] + servoOffset[0][1]);
-		pca.setServoAngle(2, las[0][2] + servoOffset[0][2]);
-		// Serial.println(String("las0: ") + String(las[0][0] + servoOffset[0][0]) + String(" ") + String(las[0][1] + servoOffset[0][1]) + String(" ") + String(las[0][2] + servoOffset[0][2]));
-		break;
-	case 1:
-		pca.setServoAngle(7, las[1][0] + servoOffset[1][0]);
-		pca.setServoAngle(6, las[1][1] + servoOffset[1][1]);
-		pca.setServoAngle(5, las[1][2] + servoOffset[1][2]);
-		// Serial.println(String("las1: ") + String(las[1][0] + servoOffset[1][0]) + String(" ") + String(las[1][1] + servoOffset[1][1]) + String(" ") + String(las[1][2] + servoOffset[1][2]));
-		break;
-	case 2:
-		pca.setServoAngle(8, las[2][0] + servoOffset[2][0]);
-		pca.setServoAngle(9, 180 - las[2][1] - servoOffset[2][1]);
-		pca.setServoAngle(10, 180 - las[2][2] - servoOffset[2][2]);
-		// Serial.println(String("las2: ") + String(las[2][0] + servoOffset[2][0]) + String(" ") + String(180 - las[2][1] - servoOffset[2][1]) + String(" ") + String(180 - las[2][2] - servoOffset[2][2]));
-		break;
-	case 3:
-		pca.setServoAngle(15, las[3][0] + servoOffset[3][0]);
-		pca.setServoAngle(14, 180 - las[3][1] - servoOffset[3][1]);
-		pca.setServoAngle(13, 180 - las[3][2] - servoOffset[3][2]);
-		// Serial.println(String("las3: ") + String(las[3][0] + servoOffset[3][0]) + String(" ") + String(180 - las[3][1] - servoOffset[3][1]) + String(" ") + String(180 - las[3][2] - servoOffset[3][2]));
-		break;
-	default:
-		break;
+		servoOutputSetJoint(x, j, las[x][j], true);
 	}
+	servoOutputCommitFrame();
 }
 
 void updateLegxWithoutOffset(u8 n)
 {
-	switch (n)
+	servoOutputBeginFrame();
+	for (u8 j = 0; j < 3; j++)
 	{
-	case 0:
-		pca.setServoAngle(0, las[0][0]);
-		pca.setServoAngle(1, las[0][1]);
-		pca.setServoAngle(2, las[0][2]);
-		// Serial.println(">>>1:");
-		// Serial.println(String(las[0][0]) + String(" ") + String(las[0][1]) + String(" ") + String(las[0][2]));
-		// Serial.println(">>>2:");
-		// Serial.println(String(las[0][0] + servoOffset[0][0]) + String(" ") + String(las[0][1] + servoOffset[0][1]) + String(" ") + String(las[0][2] + servoOffset[0][2]));
-		break;
-	case 1:
-		pca.setServoAngle(7, las[1][0]);
-		pca.setServoAngle(6, las[1][1]);
-		pca.setServoAngle(5, las[1][2]);
-		// Serial.println(">>>1:");
-		// Serial.println(String(las[1][0]) + String(" ") + String(las[1][1]) + String(" ") + String(las[1][2]));
-		// Serial.println(">>>2:");
-		// Serial.println(String(las[1][0] + servoOffset[1][0]) + String(" ") + String(las[1][1] + servoOffset[1][1]) + String(" ") + String(las[1][2] + servoOffset[1][2]));
-		break;
-	case 2:
-		pca.setServoAngle(8, las[2][0]);
-		pca.setServoAngle(9, 180 - las[2][1]);
-		pca.setServoAngle(10, 180 - las[2][2]);
-		// Serial.println(">>>1:");
-		// Serial.println(String(las[2][0]) + String(" ") + String(180 - las[2][1]) + String(" ") + String(180 - las[2][2]));
-		// Serial.println(">>>2:");
-		// Serial.println(String(las[2][0] + servoOffset[2][0]) + String(" ") + String(180 - las[2][1] - servoOffset[2][1]) + String(" ") + String(180 - las[2][2] - servoOffset[2][2]));
-		break;
-	case 3:
-		pca.setServoAngle(15, las[3][0]);
-		pca.setServoAngle(14, 180 - las[3][1]);
-		pca.setServoAngle(13, 180 - las[3][2]);
-		// Serial.println(">>>1:");
-		// Serial.println(String(las[3][0]) + String(" ") + String(180 - las[3][1]) + String(" ") + String(180 - las[3][2]));
-		// Serial.println(">>>2:");
-		// Serial.println(String(las[3][0] + servoOffset[3][0]) + String(" ") + String(180 - las[3][1] - servoOffset[3][1]) + String(" ") + String(180 - las[3][2] - servoOffset[3][2]));
-		break;
-	default:
-		break;
+		servoOutputSetJoint(n, j, las[n][j], false);
 	}
+	servoOutputCommitFrame();
 }
 
+// The whole 12-servo pose is published as one frame, task_ServoOutput flushes it in a single I2C transaction.
 void updateServoAngle(bool b)
 {
-	if (b)
+	servoOutputSetLegs(las, b); // b: with the servo offsets.
+}
+
+/**
+ * @brief Inverse kinematics of n legs, float only. Structure-of-arrays layout: x[i], y[i], z[i] is the foot
+ * point of leg i, a[i], b[i], c[i] receive its servo angles in degrees.
+ * Agrees with the former double-precision cooToA() within 0.01 degree on a and c. b differs by less than
+ * 1 degree, since it is no longer truncated to an integer by map(). Where the foot is nearer the body axis
+ * than L1 the former solver mirrored it outwards, this one does not.
+ */
+static void cooToA_Legs(const float *x, const float *y, const float *z, float *a, float *b, float *c, int n)
+{
+	for (int i = 0; i < n; i++)
 	{
-		updateLegx(0); // si b=true MAJ commande des servos P0
-		updateLegx(1);
-		updateLegx(2);
-		updateLegx(3);
+		if (ikTableLookup(x[i], y[i], z[i], &a[i], &b[i], &c[i]))
+		{
+			continue; // IK_MODE_TABLE and inside the grid.
+		}
+		float px = x[i], py = y[i], pz = z[i];
+		float r = sqrtf(py * py + pz * pz); // Distance from the body axis, the axis of a.
+		a[i] = 90.0f - fastAtan2(pz, py) * FAST_RAD_TO_DEG;
+
+		// Foot point relative to the intersection of L1 and L2, in the leg plane: dx along x, dr outwards from the body axis.
+		float dx = px, dr = r - L1;
+		float l23 = sqrtf(dx * dx + dr * dr);
+		// Pulled back onto DR or out onto DR_MIN along the same direction, as clampFootPoint() does.
+		l23 = constrain(l23, (float)DR_MIN, (float)DR);
+		float gamma1 = fastAtan2(dx, dr); // asin(dx / l23) mirrors a foot nearer the body axis than L1.
+		float v = constrain((L2 * L2 + l23 * l23 - L3 * L3) / (2 * L2 * l23), -1.0f, 1.0f); // cos(gamma2)
+		float k = constrain((L2 * L2 + L3 * L3 - l23 * l23) / (2 * L2 * L3), -1.0f, 1.0f);	 // cos(gamma3)
+		b[i] = 90.0f - (gamma1 - fastAcos(v)) * FAST_RAD_TO_DEG;
+		c[i] = 180.0f - fastAcos(k) * FAST_RAD_TO_DEG;
 	}
-	else
+}
+
+/**
+ * @brief Forward kinematics, the inverse of cooToA(). For a point outside DR_MIN ~ DR it gives the point clampFootPoint() moves it to.
+ *
+ * @param abc Servo angles of one leg as cooToA() gives them, unit: degree.
+ * @param xyz Foot point in the leg frame.
+ */
+void aToCoo(const float *abc, float *xyz)
+{
+	float a = abc[0] * FAST_DEG_TO_RAD;
+	float b = (90.0f - abc[1]) * FAST_DEG_TO_RAD; // Thigh angle from the L1 direction towards x.
+	float bc = b + abc[2] * FAST_DEG_TO_RAD;	   // Calf angle.
+	float r = L1 + L2 * fastCos(b) + L3 * fastCos(bc);
+	xyz[0] = L2 * fastSin(b) + L3 * fastSin(bc);
+	xyz[1] = r * fastSin(a);
+	xyz[2] = r * fastCos(a);
+}
+
+/**
+ * @brief Move a foot point outside DR_MIN ~ DR from the intersection of L1 and L2 onto the nearest of them,
+ * along the same direction, the way cooToA() does, without trig. The result is where the foot actually goes,
+ * which is what lastPt must hold. A point right on the intersection goes straight outwards from the body axis.
+ *
+ * @return true if the point was moved.
+ */
+bool clampFootPoint(float *xyz)
+{
+	float r = sqrtf(xyz[1] * xyz[1] + xyz[2] * xyz[2]);
+	float ry = r > 0 ? xyz[1] / r : 1, rz = r > 0 ? xyz[2] / r : 0; // Outwards from the body axis.
+	float dx = xyz[0], dr = r - L1;									  // In the leg plane, as in cooToA_Legs().
+	float d2 = dx * dx + dr * dr;
+	if (d2 <= DR * DR && d2 >= DR_MIN * DR_MIN)
+	{
+		return false;
+	}
+	float d = sqrtf(d2);
+	if (d == 0)
 	{
-		updateLegxWithoutOffset(0); // si b=true MAJ commande des servos P0 sans le offset (calibrage ?)
-		updateLegxWithoutOffset(1);
-		updateLegxWithoutOffset(2);
-		updateLegxWithoutOffset(3);
+		dr = d = 1;
 	}
+	float k = (d2 > DR * DR ? DR : DR_MIN) / d;
+	float rk = L1 + k * dr;
+	xyz[0] = k * dx;
+	xyz[1] = rk * ry;
+	xyz[2] = rk * rz;
+	return true;
+}
+
+bool isInActiveRadius(float x, float y, float z)
+{
+	float xyz[] = {x, y, z};
+	return !clampFootPoint(xyz);
 }
 
 void cooToA_All(float (*Pt)[3], float (*ag)[3])
 {
-	// for (u8 i = 0; i < 4; i++) {
-	//	cooToA(Pt[i], ag[i]);
-	// }
-	cooToA(Pt[0], ag[0]);
-	cooToA(Pt[1], ag[1]);
-	cooToA(Pt[2], ag[2]);
-	cooToA(Pt[3], ag[3]);
+	float x[4], y[4], z[4], a[4], b[4], c[4];
+	for (u8 i = 0; i < 4; i++)
+	{
+		x[i] = Pt[i][0];
+		y[i] = Pt[i][1];
+		z[i] = Pt[i][2];
+	}
+	cooToA_Legs(x, y, z, a, b, c, 4);
+	for (u8 i = 0; i < 4; i++)
+	{
+		ag[i][0] = a[i];
+		ag[i][1] = b[i];
+		ag[i][2] = c[i];
+	}
 }
 
 void cooToA(float x, float y, float z, float *abc)
 {
-	float xyz[] = {x, y, z};
-	cooToA(xyz, abc);
+	cooToA_Legs(&x, &y, &z, &abc[0], &abc[1], &abc[2], 1);
 }
 
 void cooToA(float *xyz, float *abc)
 {
-	float a, b, c, d, x, y, z, k;
-
-	x = xyz[0];
-	y = xyz[1];
-	z = xyz[2];
-
-	// Serial.println(String(x) + String(" ") + String(y) + String(" ") + String(z));
-
-	float x_3 = 0, x_4, x_5 = 0, l23 = 0, w = 0, v = 0;
-
-	a = PI / 2 - atan2(z, y); // a= pi/2 - arctan(z/y) --> voir S1/S2
-
-	// position de PxM1 dans le repère de la patte
-	x_3 = 0;		   // Intersection point of L1 and L2: x 
-	x_4 = L1 * sin(a); // Intersection point of L1 and L2: y ATTENTION ERREUR PROJECTION ?
-	x_5 = L1 * cos(a); // Intersection point of L1 and L2: z ATTENTION ERREUR PROJECTION ?
-
-	// calcule la norme de la distance entre les points PxP et PxM1
-	d = sqrt(pow((z - x_5), 2) + pow((y - x_4), 2) + pow((x - x_3), 2));
-	if (d > DR) // si la distance entre PxP et PxM1 est plus grande que la référence alors on recalcule la position du pied ? 
-	{
-		k = DR / d; // pas le même k que précédemment (rapport entre taille jambe de référence et écart actuel entre PxP et PxM1)
-		x = k * (x - x_3) + x_3; 
-		y = k * (y - x_4) + x_4;
-		z = k * (z - x_5) + x_5;
-	}
-	// l23 est une maj du d (si la position du pied a changé)
-	l23 = sqrt(pow((z - x_5), 2) + pow((y - x_4), 2) + pow((x - x_3), 2));
-	// l23 = constrain(l23, 0, L2 + L3);
-	w = (x - x_3) / l23; // w = sin(gamma1) --> voir S1
-	v = (L2 * L2 + l23 * l23 - L3 * L3) / (2 * L2 * l23); // v = cos(gamma2) --> voir S1
-	b = asin(w) - acos(v); // angle rotation M1 (axe z)
-	c = PI - acos((pow(L2, 2) + pow(L3, 2) - pow(l23, 2)) / (2 * L3 * L2)); // c = Pi - gamma3 --> c angle rotation M2 (axe z)
-	a = a / PI * 180; // passage en degrés des angles
-	b = b / PI * 180;
-	c = c / PI * 180;
-	b = map(b, -90, 90, 180, 0); // ????
-	abc[0] = a;
-	abc[1] = b;
-	abc[2] = c;
-	// printf("abc: %f, %f, %f, %f, %f, %f, %f \n", a, b, c, x, y, z, l23);
-	//   Serial.println(String(a) + String(" ") + String(b) + String(" ") + String(c));
+	cooToA_Legs(&xyz[0], &xyz[1], &xyz[2], &abc[0], &abc[1], &abc[2], 1);
 }
 extern PreferencesPro prefs;
 void getServoOffsetFromStorage()
@@ -818,6 +814,8 @@ void getServoOffsetFromStorage()
 	else
 	{
 		prefs.get(KEY_SERVO_OFFSET, servoOffset);
+		servoOutputLoadOffsets();
+		stepCacheInvalidate();
 		// for (int i = 0; i < 4; i++)
 		// {
 		// 	for (int j = 0; j < 3; j++)
@@ -14,6 +14,19 @@
 
 #include "Public.h"
 
+#define TICK_MS 10 //The time length of each tick, the unit is ms, and the coordinate point is updated every tick.
+#define STEP_HEIGHT 15
+// The movement speed of the leg end point. Too fast speed will damage the servo. Unit: x mm / 10ms
+#define SPEED_MIN 1
+#define SPEED_MAX 8
+
+/**
+ * @brief define the body length and width , between adjacent servo.
+ * @LEN_BD: body length / 2 = 136.4 / 2.
+ * @WID_BD: body width / 2 = 80 / 2.
+ */
+constexpr float LEN_BD = 68.2, WID_BD = 40;
+
 void setMoveSpeed(int spd);
 void move_leg_to_point_directly(float (*startPt)[3], float (*endPt)[3]);
 void cooToA_All(float (*Pt)[3], float (*ag)[3]);
@@ -23,6 +36,7 @@ void standUp();
 void move_step_by_step(float (*startPt)[3], float (*end__Pt)[3], int spd = 5);
 // void move_any(int alpha, float stepLength, int gama);
 void move_any(int alpha, float stepLength, int gama, int spd = 5);
+void getStepTarget(float alpha, float stepLength, float gama, float (*newPt)[3]);
 // void action_twist(float (*startPt)[3], float (*end__Pt)[3], float tickLength);
 void action_twist(float (*startPt)[3], float (*end__Pt)[3], float tickLength, bool isContainedOffset = true);
 void twist_any(int alpha, int beta, int gama);
@@ -37,6 +51,9 @@ void updateServoAngle(bool b = true);
 void cooToA_All(float (*Pt)[3], float (*ag)[3]);
 void cooToA(float x, float y, float z, float *abc);
 void cooToA(float *xyz, float *abc);
+void aToCoo(const float *abc, float *xyz);
+bool clampFootPoint(float *xyz);
+bool isInActiveRadius(float x, float y, float z);
 void getServoOffsetFromStorage();
 
 #endif
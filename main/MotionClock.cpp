@@ -0,0 +1,137 @@
+/**
+ * @file MotionClock.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Fixed-rate motion tick. Trajectory loops wait on an absolute schedule instead of sleeping TICK_MS after their work.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "MotionClock.h"
+
+#define TICK_PERIOD pdMS_TO_TICKS(TICK_MS)
+
+static TickType_t lastWake = 0; // RTOS tick of the last deadline.
+static int64_t lastWakeUs = 0;	// esp_timer time when the last deadline was met.
+static u8 tickPolicy = TICK_POLICY_SKIP;
+static MotionClockStats clockStats = {0, 0, 0, 0, 0};
+static WindowStats<u32, MOTION_JITTER_WINDOW> jitterWindow; // Written by the motion task only.
+static volatile bool isJitterClearPending = false;
+
+/**
+ * @brief Anchor the schedule at the current time. A move started within one tick of the
+ * previous one keeps its schedule, so consecutive moves run at the same rate.
+ */
+void motionClockStart()
+{
+	TickType_t now = xTaskGetTickCount();
+	if (now - lastWake > TICK_PERIOD)
+	{
+		lastWake = now;
+		lastWakeUs = esp_timer_get_time();
+	}
+}
+
+/**
+ * @brief Wait for the deadline of the tick after t. Use as the step of a trajectory loop:
+ * for (int t = 0; t <= stepTicks; t = motionTick(t, stepTicks))
+ *
+ * @param t Tick just played.
+ * @param lastTick Last tick of the move.
+ * @return The tick to play next, larger than lastTick once the move is finished.
+ */
+int motionTick(int t, int lastTick)
+{
+	TickType_t prevWake = lastWake;
+	TickType_t late = xTaskGetTickCount() - lastWake;
+	int next = t + 1;
+	if (late > TICK_PERIOD) // Exactly one period late is the next deadline itself, still on time.
+	{
+		clockStats.overruns++;
+		if (tickPolicy == TICK_POLICY_STRETCH)
+		{
+			lastWake += late; // Play the next tick now and restart the schedule from here.
+		}
+		else
+		{
+			int missed = (late - 1) / TICK_PERIOD; // Deadlines already behind us, the one due now is not.
+			if (next > lastTick)
+			{
+				missed = 0;
+			}
+			else if (next + missed > lastTick)
+			{
+				missed = lastTick - next;
+			}
+			next += missed;
+			clockStats.skippedTicks += missed;
+			lastWake += missed * TICK_PERIOD;
+			vTaskDelayUntil(&lastWake, TICK_PERIOD);
+		}
+	}
+	else
+	{
+		vTaskDelayUntil(&lastWake, TICK_PERIOD);
+	}
+
+	int64_t nowUs = esp_timer_get_time();
+	int64_t jitterUs = (nowUs - lastWakeUs) - (int64_t)(lastWake - prevWake) * portTICK_PERIOD_MS * 1000;
+	jitterUs = jitterUs < 0 ? -jitterUs : jitterUs;
+	lastWakeUs = nowUs;
+	clockStats.ticks++;
+	clockStats.totalJitterUs += jitterUs;
+	clockStats.maxJitterUs = jitterUs > clockStats.maxJitterUs ? jitterUs : clockStats.maxJitterUs;
+	if (isJitterClearPending)
+	{
+		isJitterClearPending = false;
+		jitterWindow.clear();
+	}
+	jitterWindow.push(jitterUs);
+	timelineRecordTicks(next - t);
+	return next;
+}
+
+/**
+ * @brief Hold the pose for ms on the motion schedule. Unlike vTaskDelay(), the pause is part of a
+ * recorded timeline and the next move keeps the schedule.
+ */
+void motionPause(u32 ms)
+{
+	int lastTick = ms / TICK_MS - 1;
+	motionClockStart();
+	for (int t = 0; t <= lastTick; t = motionTick(t, lastTick))
+	{
+	}
+}
+
+void setMotionTickPolicy(u8 policy)
+{
+	tickPolicy = policy == TICK_POLICY_STRETCH ? TICK_POLICY_STRETCH : TICK_POLICY_SKIP;
+}
+
+u8 getMotionTickPolicy()
+{
+	return tickPolicy;
+}
+
+const MotionClockStats &getMotionClockStats()
+{
+	return clockStats;
+}
+
+const WindowStats<u32, MOTION_JITTER_WINDOW> &getMotionJitterWindow()
+{
+	return jitterWindow;
+}
+
+/**
+ * @brief Clear the counters now. The jitter window is cleared by the motion task on its next tick,
+ * until then it still reports the ticks before the clear.
+ */
+void clearMotionClockStats()
+{
+	memset(&clockStats, 0, sizeof(clockStats));
+	isJitterClearPending = true;
+}
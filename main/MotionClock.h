@@ -0,0 +1,43 @@
+/**
+ * @file MotionClock.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Fixed-rate motion tick. Trajectory loops wait on an absolute schedule instead of sleeping TICK_MS after their work.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _MOTIONCLOCK_h
+#define _MOTIONCLOCK_h
+
+#include "Public.h"
+
+//What a trajectory loop does when it misses a tick deadline.
+#define TICK_POLICY_SKIP	0	//Drop the missed ticks, the move keeps its duration. The last tick is never dropped.
+#define TICK_POLICY_STRETCH 1	//Play every tick, the schedule restarts from the late tick and the move ends late.
+
+#define MOTION_JITTER_WINDOW 100	//Recent jitter statistics cover this many ticks, 1 s.
+
+//Motion tick counters, cleared by clearMotionClockStats().
+struct MotionClockStats
+{
+	u32 ticks;			//Ticks played.
+	u32 overruns;		//Waits entered after the deadline had already passed.
+	u32 skippedTicks;	//Ticks dropped by TICK_POLICY_SKIP.
+	u32 maxJitterUs;	//Largest difference between a measured and a scheduled tick interval.
+	uint64_t totalJitterUs;	//Mean = totalJitterUs / ticks.
+};
+
+void motionClockStart();
+int motionTick(int t, int lastTick);
+void motionPause(u32 ms);
+
+void setMotionTickPolicy(u8 policy);
+u8 getMotionTickPolicy();
+const MotionClockStats &getMotionClockStats();
+const WindowStats<u32, MOTION_JITTER_WINDOW> &getMotionJitterWindow();
+void clearMotionClockStats();
+
+#endif
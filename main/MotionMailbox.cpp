@@ -0,0 +1,112 @@
+/**
+ * @file MotionMailbox.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Latest-wins mailbox of typed motion commands, one slot per command class.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "MotionMailbox.h"
+
+// A newer command of a class overwrites the unread one, commands of different classes are taken in
+// the order they were posted. The slots are copied under the spinlock, so any task can post.
+static MotionCommand slots[MOTION_SLOTS];
+static u32 slotSeq[MOTION_SLOTS];
+static u8 pendingMask = 0;
+static u32 postSeq = 0;
+static portMUX_TYPE mailboxMux = portMUX_INITIALIZER_UNLOCKED;
+
+static int motionSlotOf(char commandChar)
+{
+	switch (commandChar)
+	{
+	case ACTION_MOVE_ANY:
+		return MOTION_SLOT_WALK;
+	case ACTION_TWIST:
+		return MOTION_SLOT_POSE;
+	case ACTION_BODY_HEIGHT:
+		return MOTION_SLOT_HEIGHT;
+	case ACTION_INSTALLATION:
+	case ACTION_CALIBRATE:
+	case ACTION_UP_DOWN:
+	case ACTION_DANCING:
+		return MOTION_SLOT_ACTION;
+	default:
+		return -1;
+	}
+}
+
+bool isMotionCommand(char commandChar)
+{
+	return motionSlotOf(commandChar) >= 0;
+}
+
+/**
+ * @brief Parse "C#p1#p2#...#" with MessageParser, in place and without allocating.
+ */
+bool motionCommandParse(const char *msg, MotionCommand &cmd)
+{
+	MessageParser parser;
+	parser.parser(msg, strlen(msg));
+	cmd.commandChar = parser.commandChar;
+	cmd.paramterCount = parser.paramterCount;
+	memcpy(cmd.paramters, parser.paramters, sizeof(cmd.paramters));
+	return isMotionCommand(cmd.commandChar);
+}
+
+/**
+ * @brief Post a command and wake the motion task. Never blocks and never allocates.
+ */
+void motionMailboxPost(const MotionCommand &cmd)
+{
+	int slot = motionSlotOf(cmd.commandChar);
+	if (slot < 0)
+	{
+		return;
+	}
+	portENTER_CRITICAL(&mailboxMux);
+	slots[slot] = cmd;
+	slotSeq[slot] = ++postSeq;
+	pendingMask |= 1 << slot;
+	portEXIT_CRITICAL(&mailboxMux);
+	if (taskHandle_Motion_Service != NULL)
+	{
+		xTaskNotifyGive(taskHandle_Motion_Service);
+	}
+}
+
+/**
+ * @brief Take the oldest pending command, motion task only.
+ */
+bool motionMailboxTake(MotionCommand &cmd)
+{
+	bool isTaken = false;
+	portENTER_CRITICAL(&mailboxMux);
+	int oldest = -1;
+	for (int i = 0; i < MOTION_SLOTS; i++)
+	{
+		if ((pendingMask & (1 << i)) && (oldest < 0 || (int32_t)(slotSeq[i] - slotSeq[oldest]) < 0))
+		{
+			oldest = i;
+		}
+	}
+	if (oldest >= 0)
+	{
+		cmd = slots[oldest];
+		pendingMask &= ~(1 << oldest);
+		isTaken = true;
+	}
+	portEXIT_CRITICAL(&mailboxMux);
+	return isTaken;
+}
+
+/**
+ * @brief Block the motion task until a command is posted, or timeout passes.
+ */
+bool motionMailboxWait(TickType_t timeout)
+{
+	return pendingMask != 0 || ulTaskNotifyTake(pdTRUE, timeout) > 0;
+}
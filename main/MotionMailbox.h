@@ -0,0 +1,37 @@
+/**
+ * @file MotionMailbox.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Latest-wins mailbox of typed motion commands, one slot per command class.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _MOTIONMAILBOX_h
+#define _MOTIONMAILBOX_h
+
+#include "Public.h"
+
+#define MOTION_SLOT_WALK	0	//F, the latest walk velocity.
+#define MOTION_SLOT_POSE	1	//E, the latest body pose.
+#define MOTION_SLOT_HEIGHT	2	//B, the latest body height.
+#define MOTION_SLOT_ACTION	3	//A, J, L, O, the latest discrete action.
+#define MOTION_SLOTS		4
+
+//A parsed motion message, the fields match MessageParser: paramters[0] is the command word.
+struct MotionCommand
+{
+	char commandChar;
+	int paramterCount;	//The number of parameters not including the command word.
+	int paramters[COMMANDS_COUNT_MAX];
+};
+
+bool isMotionCommand(char commandChar);
+bool motionCommandParse(const char *msg, MotionCommand &cmd);
+void motionMailboxPost(const MotionCommand &cmd);
+bool motionMailboxTake(MotionCommand &cmd);
+bool motionMailboxWait(TickType_t timeout);
+
+#endif
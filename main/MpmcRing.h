@@ -0,0 +1,119 @@
+/**
+ * @file MpmcRing.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Lock-free bounded ring for several producer and consumer tasks, slots stored inline.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _MPMCRING_h
+#define _MPMCRING_h
+
+#include <atomic>
+#include <stdint.h>
+#include "SpscRing.h"
+
+//Any task may push and any task may pop, nobody ever blocks. N must be a power of two.
+//Each slot carries a sequence number: a producer claims a position with a CAS on head and publishes
+//the slot by storing position + 1, a consumer claims it with a CAS on tail and frees it for the next
+//lap by storing position + N. T is copied in and out, so keep it trivially copyable.
+template <typename T, uint32_t N>
+class MpmcRing
+{
+	static_assert(N > 0 && (N & (N - 1)) == 0, "MpmcRing length must be a power of two");
+
+private:
+	struct Slot
+	{
+		std::atomic<uint32_t> seq;
+		T value;
+	};
+
+	alignas(SPSC_RING_ALIGN) std::atomic<uint32_t> head; //Next position to claim for writing.
+	alignas(SPSC_RING_ALIGN) std::atomic<uint32_t> tail; //Next position to claim for reading.
+	alignas(SPSC_RING_ALIGN) Slot slots[N];
+
+public:
+	MpmcRing() : head(0), tail(0)
+	{
+		for (uint32_t i = 0; i < N; i++)
+		{
+			slots[i].seq.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	bool push(const T &value)
+	{
+		uint32_t pos = head.load(std::memory_order_relaxed);
+		Slot *slot;
+		while (1)
+		{
+			slot = &slots[pos & (N - 1)];
+			int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+			if (diff == 0)
+			{
+				if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false; //Full, the slot still holds the value of the previous lap.
+			}
+			else
+			{
+				pos = head.load(std::memory_order_relaxed);
+			}
+		}
+		slot->value = value;
+		slot->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T &value)
+	{
+		uint32_t pos = tail.load(std::memory_order_relaxed);
+		Slot *slot;
+		while (1)
+		{
+			slot = &slots[pos & (N - 1)];
+			int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - (pos + 1));
+			if (diff == 0)
+			{
+				if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false; //Empty, the slot is not published yet.
+			}
+			else
+			{
+				pos = tail.load(std::memory_order_relaxed);
+			}
+		}
+		value = slot->value;
+		slot->seq.store(pos + N, std::memory_order_release);
+		return true;
+	}
+
+	uint32_t length() const
+	{
+		uint32_t t = tail.load(std::memory_order_acquire);
+		uint32_t h = head.load(std::memory_order_acquire);
+		return h - t < N ? h - t : N; //Both move under us, a snapshot only.
+	}
+
+	bool isEmpty() const
+	{
+		return length() == 0;
+	}
+};
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file PoseController.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Non-blocking 6-DOF body pose. The feet stay on the ground while the body translates and rotates above them.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "PoseController.h"
+
+// Hip of each leg in the body frame. The leg frames share the x and z axes of the body, y points down.
+static const float hipPt[4][3] = {{LEN_BD, 0, WID_BD}, {-LEN_BD, 0, WID_BD}, {-LEN_BD, 0, -WID_BD}, {LEN_BD, 0, -WID_BD}};
+
+struct PoseState
+{
+	PoseSetpoint setpoint;
+	float targetPt[4][3];	// Foot points of the setpoint, solved once per update.
+	float trackPt[4][3];	// Foot points played on the last tick.
+	bool active;
+};
+
+static PoseState pose = {{0, 0, 0, 0, 0, 0}, {}, {}, false};
+
+static void poseMultiply(const float (*a)[3], const float (*b)[3], float (*m)[3])
+{
+	for (u8 i = 0; i < 3; i++)
+	{
+		for (u8 k = 0; k < 3; k++)
+		{
+			m[i][k] = a[i][0] * b[0][k] + a[i][1] * b[1][k] + a[i][2] * b[2][k];
+		}
+	}
+}
+
+/**
+ * @brief The feet are fixed on the ground, so in the leg frames they take the inverse body motion:
+ * P = M * (H + C - T) - H, M = Yaw * Pitch * Roll, H the hip, C the stance at bodyHeight, T the translation.
+ */
+static void poseSolveTarget()
+{
+	const PoseSetpoint &sp = pose.setpoint;
+	float sa = fastSinDeg(sp.pitch), ca = fastCosDeg(sp.pitch);
+	float sb = fastSinDeg(sp.roll), cb = fastCosDeg(sp.roll);
+	float sc = fastSinDeg(sp.yaw), cc = fastCosDeg(sp.yaw);
+	const float roll[3][3] = {{1, 0, 0}, {0, cb, sb}, {0, -sb, cb}};
+	const float pitch[3][3] = {{ca, -sa, 0}, {sa, ca, 0}, {0, 0, 1}};
+	const float yaw[3][3] = {{cc, 0, sc}, {0, 1, 0}, {-sc, 0, cc}};
+	float yawPitch[3][3], m[3][3];
+	poseMultiply(yaw, pitch, yawPitch);
+	poseMultiply(yawPitch, roll, m);
+
+	const float t[3] = {sp.x, -sp.y, sp.z}; // Raising the body lengthens the legs.
+	for (u8 j = 0; j < 4; j++)
+	{
+		float p[3] = {hipPt[j][0] + calibratePosition[j][0] - t[0],
+					  hipPt[j][1] + bodyHeight - t[1],
+					  hipPt[j][2] + calibratePosition[j][2] - t[2]};
+		for (u8 i = 0; i < 3; i++)
+		{
+			pose.targetPt[j][i] = m[i][0] * p[0] + m[i][1] * p[1] + m[i][2] * p[2] - hipPt[j][i];
+		}
+	}
+}
+
+static void poseActivate()
+{
+	poseSolveTarget();
+	if (!pose.active)
+	{
+		memcpy(pose.trackPt, lastPt, sizeof(pose.trackPt));
+		pose.active = true;
+		motionClockStart();
+	}
+}
+
+/**
+ * @brief Set a new pose. Returns at once, poseTick() moves the feet there. A setpoint streamed every tick
+ * is followed tick by tick.
+ */
+void poseSetTarget(const PoseSetpoint &sp)
+{
+	pose.setpoint = sp;
+	poseActivate();
+}
+
+/**
+ * @brief Change bodyHeight under the current pose, without blocking.
+ */
+void poseSetHeight(int h)
+{
+	bodyHeight = constrain(h, BODY_HEIGHT_MIN, BODY_HEIGHT_MAX);
+	poseActivate();
+}
+
+/**
+ * @brief Play one tick: all feet move along straight lines towards the setpoint, scaled so the furthest
+ * one moves at most POSE_SPEED_MAX.
+ *
+ * @return true while the pose is still moving.
+ */
+bool poseTick()
+{
+	if (!pose.active)
+	{
+		return false;
+	}
+	float maxLength = 0;
+	for (u8 j = 0; j < 4; j++)
+	{
+		float d = sqrtf(square(pose.targetPt[j][0] - pose.trackPt[j][0]) + square(pose.targetPt[j][1] - pose.trackPt[j][1]) +
+						square(pose.targetPt[j][2] - pose.trackPt[j][2]));
+		maxLength = fmaxf(maxLength, d);
+	}
+	bool isReached = maxLength <= POSE_SPEED_MAX;
+	float k = isReached ? 1.0f : POSE_SPEED_MAX / maxLength;
+	for (u8 j = 0; j < 4; j++)
+	{
+		for (u8 i = 0; i < 3; i++)
+		{
+			pose.trackPt[j][i] += (pose.targetPt[j][i] - pose.trackPt[j][i]) * k;
+		}
+		memcpy(lastPt[j], pose.trackPt[j], sizeof(lastPt[j]));
+		clampFootPoint(lastPt[j]); // Where the foot really is.
+	}
+	cooToA_All(pose.trackPt, las);
+	updateServoAngle();
+	motionTick(0, 0);
+	pose.active = !isReached;
+	return pose.active;
+}
+
+/**
+ * @brief Play the pose to its setpoint, then forget the setpoint: the next action owns the legs.
+ */
+void poseFinish()
+{
+	while (poseTick())
+	{
+	}
+	memset(&pose.setpoint, 0, sizeof(pose.setpoint));
+}
+
+bool isPoseActive()
+{
+	return pose.active;
+}
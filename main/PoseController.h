@@ -0,0 +1,33 @@
+/**
+ * @file PoseController.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Non-blocking 6-DOF body pose. The feet stay on the ground while the body translates and rotates above them.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _POSECONTROLLER_h
+#define _POSECONTROLLER_h
+
+#include "Public.h"
+
+#define POSE_SPEED_MAX		5.0f	//The foot that moves furthest covers at most this per tick, unit: mm / tick.
+
+//Body frame: x forward, y up, z towards the left legs. Angles in degree.
+//pitch > 0 lifts the head, roll > 0 lifts the left side, yaw > 0 turns the head to the left.
+struct PoseSetpoint
+{
+	float x, y, z;
+	float roll, pitch, yaw;
+};
+
+void poseSetTarget(const PoseSetpoint &sp);
+void poseSetHeight(int h);
+bool poseTick();
+void poseFinish();
+bool isPoseActive();
+
+#endif
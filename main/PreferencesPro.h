@@ -26,6 +26,9 @@
 #define KEY_WIFI_SSID		"KEY_2"
 #define KEY_WIFI_PSD		"KEY_3"
 #define KEY_LED_MODE		"KEY_4"
+#define KEY_SERVO_BUS_CLOCK	"KEY_5"
+#define KEY_MOTION_TICK_POLICY "KEY_6"
+#define KEY_IK_MODE			"KEY_7"
 
 //https://docs.espressif.com/projects/esp-idf/zh_CN/latest/esp32/api-reference/storage/nvs_flash.html
 //The operation object of NVS is a key-value, where the key is an ASCII string, and the currently supported maximum key length is 15 characters.
@@ -41,26 +41,44 @@
 #include "BuiltInLed.h"
 
 #include "DanceMovements.h"
+#include "FastMath.h"
+#include "WindowStats.h"
+#include "LegTopology.h"
 #include "Motion.h"
+#include "MotionClock.h"
+#include "PoseController.h"
+#include "IKTable.h"
+#include "GaitEngine.h"
+#include "StepCache.h"
+#include "Timeline.h"
+#include "ClipStore.h"
+#include "MotionMailbox.h"
+#include "CommandProtocol.h"
+#include "ServoOutput.h"
 
 typedef unsigned char u8;
 typedef unsigned short u16;
 typedef unsigned long u32;
 
-#define square(x) pow(x, 2)
+#define square(x) ((x) * (x))
 
 extern Freenove_PCA9685 pca;
 
-extern DataQueue<String> mqMotion; //	Motion message queue, When there are too many messages, some messages can be ignored to reduce latency.
-extern DataQueue<String> mqInfo;   //  Info message queue, Important, can not ignore.
-extern DataQueue<String> mqTx;    // Ble message
-extern DataQueue<int> mqBz;        // Buzzer queue
+#define MQ_INFO_LENGTH	32
+#define MQ_TX_LENGTH	32
+#define MQ_BZ_LENGTH	16
+
+extern MessageQueue<MQ_INFO_LENGTH> mqInfo;	//  Info message queue, Important, can not ignore.
+extern MessageQueue<MQ_TX_LENGTH> mqTx;		// Ble message
+extern MpmcRing<int, MQ_BZ_LENGTH> mqBz;	// Buzzer queue
 
 extern float calibratePosition[4][3];
 extern float lastPt[4][3];
+extern float movingOriginPos[4][3];
 extern float las[4][3];
 extern float servoOffset[4][3];
 extern bool isRobotStanding;
+extern int bodyHeight;
 
 extern TaskHandle_t taskHandle_Command_Service;
 extern TaskHandle_t taskHandle_Motion_Service;
@@ -70,12 +88,14 @@ extern TaskHandle_t taskHandle_Buzzered;
 extern TaskHandle_t taskHandle_Camera;
 extern TaskHandle_t taskHandle_AutoWalking;
 extern TaskHandle_t taskHandle_Secondary;
+extern TaskHandle_t taskHandle_Servo_Output;
 
 extern PreferencesPro prefs;
 
 extern pthread_mutex_t mutexPin33; //???
 
 
-extern void enterMessageQueue(String msg);
+extern void enterMessageQueue(const char *msg);
+extern void enterMessageQueue(char commandChar, const char *params);
 
 #endif
@@ -0,0 +1,290 @@
+/**
+ * @file ServoOutput.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Servo output task. Motion code publishes angle frames, a timer-paced task flushes them to the PCA9685.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "ServoOutput.h"
+#include "SpscRing.h"
+
+// The motion task pushes one frame per tick on core 1, the output task pops one per timer tick on core 0.
+// A late frame is absorbed by the ring, a backlog beyond SERVO_RING_MAX_LAG is skipped to stay current.
+static SpscRing<ServoFrame, SERVO_RING_LENGTH> frameRing;
+static ServoOutputStats outputStats = {0, 0, 0};
+
+static ServoFrame target = {{0}, 0, 0}; // Producer only, staged by servoOutputSetCount().
+static float targetAngle[LEG_JOINTS];	 // Producer only, joint angles of the leg channels in target, without servoOffset.
+static u8 targetDepth = 0;
+static volatile u32 releaseEpoch = 0;
+
+static hw_timer_t *outputTimer = NULL;
+
+static ServoMap jointMaps[2][4][3]; // [isContainedOffset][leg][joint], from servoOutputLoadOffsets().
+static ServoMap angleMap;			// Servo horn angle, no mirroring and no offset.
+
+/**
+ * @brief Map of horn = base + sign * (angle + offset), as setServoAngle() and setServoMicroSenconds() convert it.
+ */
+static ServoMap servoMapOf(float base, float sign, float offset)
+{
+	const float countPerUs = 0.20475f; // 4095 / 20000.
+	const float countPerDeg = (SERVO_PULSE_MAX - SERVO_PULSE_MIN) / 180.0f * countPerUs;
+	const float one = 1 << SERVO_MAP_SHIFT;
+	ServoMap m;
+	m.slope = lroundf(sign * countPerDeg / SERVO_MAP_ANGLE_SCALE * one);
+	m.intercept = lroundf((SERVO_PULSE_MIN * countPerUs + (base + sign * offset) * countPerDeg + 0.5f) * one); // + 0.5: round to nearest.
+	m.minCount = (SERVO_PULSE_MIN * countPerUs) + SERVO_ANGLE_MIN * countPerDeg + 0.5f;
+	m.maxCount = (SERVO_PULSE_MIN * countPerUs) + SERVO_ANGLE_MAX * countPerDeg + 0.5f;
+	return m;
+}
+
+// a: angle in 1 / SERVO_MAP_ANGLE_SCALE degree.
+static inline u16 servoMapCountScaled(const ServoMap &m, int32_t a)
+{
+	int32_t count = (m.slope * a + m.intercept) >> SERVO_MAP_SHIFT;
+	return count < m.minCount ? m.minCount : count > m.maxCount ? m.maxCount : count;
+}
+
+static inline u16 servoMapCount(const ServoMap &m, float angle)
+{
+	return servoMapCountScaled(m, angle * SERVO_MAP_ANGLE_SCALE);
+}
+
+/**
+ * @brief Rebuild the joint maps from servoOffset. Call whenever servoOffset is loaded or changed.
+ */
+void servoOutputLoadOffsets()
+{
+	angleMap = servoMapOf(0, 1, 0);
+	for (u8 leg = 0; leg < 4; leg++)
+	{
+		for (u8 joint = 0; joint < 3; joint++)
+		{
+			bool isMirrored = legTopology.joint[leg][joint].isMirrored;
+			float base = isMirrored ? 180 : 0, sign = isMirrored ? -1 : 1;
+			jointMaps[0][leg][joint] = servoMapOf(base, sign, 0);
+			jointMaps[1][leg][joint] = servoMapOf(base, sign, servoOffset[leg][joint]);
+		}
+	}
+}
+
+static void IRAM_ATTR isr_servoOutputTimer()
+{
+	BaseType_t woken = pdFALSE;
+	vTaskNotifyGiveFromISR(taskHandle_Servo_Output, &woken);
+	if (woken)
+	{
+		portYIELD_FROM_ISR();
+	}
+}
+
+void setupServoOutput()
+{
+	servoOutputLoadOffsets();
+	startTask(TASK_SERVO_OUTPUT);
+}
+
+void task_ServoOutput(void *pvParameters)
+{
+	// Attached here so the timer interrupt is allocated on this task's core, away from the motion task.
+	outputTimer = timerBegin(SERVO_OUTPUT_TIMER, 80, true); // 80MHz / 80 = 1us per count.
+	timerAttachInterrupt(outputTimer, &isr_servoOutputTimer, true);
+	timerAlarmWrite(outputTimer, SERVO_OUTPUT_PERIOD_US, true);
+	timerAlarmEnable(outputTimer);
+
+	ServoFrame frame;
+	while (1)
+	{
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		if (!frameRing.pop(frame))
+		{
+			continue; // Nothing new since the last tick, the chip already holds the latest pose.
+		}
+		while (frameRing.length() > SERVO_RING_MAX_LAG && frameRing.pop(frame))
+		{
+			outputStats.framesSkipped++;
+		}
+		outputStats.frames++;
+		pca.beginFrame();
+		if (frame.epoch == releaseEpoch) // Checked under the bus lock, servoOutputReleaseAll() bumps it there.
+		{
+			for (u8 i = 0; i < PCA9685_CHANNELS; i++)
+			{
+				if (frame.mask & (1 << i))
+				{
+					pca.setPWM(i, 0, frame.count[i]);
+				}
+			}
+		}
+		pca.commitFrame();
+	}
+	vTaskDelete(xTaskGetCurrentTaskHandle());
+}
+
+// Mark channels of target as set. The first staging after servoOutputReleaseAll() drops the mask first,
+// so only the channels set after a release are driven again.
+static inline void servoOutputStage(u16 mask)
+{
+	u32 epoch = releaseEpoch;
+	if (target.epoch != epoch)
+	{
+		target.epoch = epoch;
+		target.mask = 0;
+	}
+	target.mask |= mask;
+}
+
+void servoOutputBeginFrame()
+{
+	targetDepth++;
+}
+
+void servoOutputSetCount(u8 chn, u16 count)
+{
+	target.count[chn] = count;
+	servoOutputStage(1 << chn);
+	if (targetDepth == 0)
+	{
+		servoOutputCommitFrame();
+	}
+}
+
+/**
+ * @brief Set a channel by its servo horn angle, unit: degree. Fractions are kept.
+ */
+void servoOutputSetAngle(u8 chn, float angle)
+{
+	for (u8 n = 0; n < LEG_JOINTS; n++)
+	{
+		if (legChannel(n) == chn)
+		{
+			// The joint angle that gives this horn angle, horn = base + sign * (angle + offset).
+			float jointAngle = legTopology.joint[n / 3][n % 3].isMirrored ? 180 - angle : angle;
+			targetAngle[n] = jointAngle - servoOffset[n / 3][n % 3];
+		}
+	}
+	servoOutputSetCount(chn, servoMapCount(angleMap, angle));
+}
+
+/**
+ * @brief Set a leg servo by its joint angle from cooToA(), unit: degree. Mirroring and servoOffset are in the map.
+ */
+void servoOutputSetJoint(u8 leg, u8 joint, float angle, bool isContainedOffset)
+{
+	if (leg < 4 && joint < 3)
+	{
+		targetAngle[leg * 3 + joint] = isContainedOffset ? angle : angle - servoOffset[leg][joint];
+		servoOutputSetCount(legTopology.joint[leg][joint].channel, servoMapCount(jointMaps[isContainedOffset][leg][joint], angle));
+	}
+}
+
+// Writes joints 0~N-1 into a frame. The recursion unrolls at compile time and the channels are constants.
+template <int N>
+struct LegWriter
+{
+	static inline void write(u16 *count, const float (*ag)[3], const ServoMap (*maps)[3])
+	{
+		LegWriter<N - 1>::write(count, ag, maps);
+		count[legChannel(N - 1)] = servoMapCount(maps[(N - 1) / 3][(N - 1) % 3], ag[(N - 1) / 3][(N - 1) % 3]);
+	}
+};
+
+template <>
+struct LegWriter<0>
+{
+	static inline void write(u16 *count, const float (*ag)[3], const ServoMap (*maps)[3])
+	{
+	}
+};
+
+/**
+ * @brief Set all 12 leg servos from their joint angles in one pass, as one frame.
+ */
+void servoOutputSetLegs(const float (*ag)[3], bool isContainedOffset)
+{
+	LegWriter<LEG_JOINTS>::write(target.count, ag, jointMaps[isContainedOffset]);
+	servoOutputStage(LegMask<LEG_JOINTS>::value);
+	for (u8 n = 0; n < LEG_JOINTS; n++)
+	{
+		targetAngle[n] = isContainedOffset ? ag[n / 3][n % 3] : ag[n / 3][n % 3] - servoOffset[n / 3][n % 3];
+	}
+	if (targetDepth == 0)
+	{
+		servoOutputCommitFrame();
+	}
+}
+
+/**
+ * @brief Set all 12 leg servos from joint angles without servoOffset, in 1 / SERVO_MAP_ANGLE_SCALE degree
+ * in the order of legTopology. The current offsets are applied, as one frame.
+ */
+void servoOutputSetLegAngles(const int16_t *angle)
+{
+	for (u8 n = 0; n < LEG_JOINTS; n++)
+	{
+		target.count[legChannel(n)] = servoMapCountScaled(jointMaps[1][n / 3][n % 3], angle[n]);
+		targetAngle[n] = angle[n] * (1.0f / SERVO_MAP_ANGLE_SCALE);
+	}
+	servoOutputStage(LegMask<LEG_JOINTS>::value);
+	if (targetDepth == 0)
+	{
+		servoOutputCommitFrame();
+	}
+}
+
+void servoOutputCommitFrame()
+{
+	if (targetDepth > 0 && --targetDepth > 0)
+	{
+		return;
+	}
+	while (!frameRing.push(target)) // A frame staged across a release keeps its old epoch and is dropped.
+	{
+		outputStats.producerWaits++; // The output task is stalled, wait for it rather than lose the pose.
+		vTaskDelay(1);
+	}
+}
+
+/**
+ * @brief Targets staged so far, the last committed frame outside of a frame.
+ */
+const ServoFrame &servoOutputTarget()
+{
+	return target;
+}
+
+/**
+ * @brief Joint angles of the leg servos in target, in the order of legTopology, without servoOffset, unit: degree.
+ * Unlike the counts they do not depend on the calibration.
+ */
+const float *servoOutputTargetAngles()
+{
+	return targetAngle;
+}
+
+const ServoOutputStats &getServoOutputStats()
+{
+	return outputStats;
+}
+
+void clearServoOutputStats()
+{
+	memset(&outputStats, 0, sizeof(outputStats));
+}
+
+/**
+ * @brief Cut the pulses of all channels, from any task. Frames published or staged before the release
+ * are dropped, and the producer forgets its staged channels on the next set.
+ */
+void servoOutputReleaseAll()
+{
+	pca.beginFrame();
+	releaseEpoch++; // A frame published before the release must not drive the servos again.
+	pca.releaseAllServo();
+	pca.commitFrame();
+}
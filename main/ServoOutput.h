@@ -0,0 +1,74 @@
+/**
+ * @file ServoOutput.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Servo output task. Motion code publishes angle frames, a timer-paced task flushes them to the PCA9685.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _SERVOOUTPUT_h
+#define _SERVOOUTPUT_h
+
+#include "Public.h"
+
+#define SERVO_OUTPUT_TIMER		3					//Hardware timer 0~3 that paces the output task.
+#define SERVO_OUTPUT_PERIOD_US	(TICK_MS * 1000)	//Output cadence, one frame per motion tick.
+#define SERVO_RING_LENGTH		8					//Frames between the motion task and the output task.
+#define SERVO_RING_MAX_LAG		2					//Frames left queued after a pop, older ones are skipped.
+
+#define SERVO_ANGLE_MIN			5					//Servo horn travel, unit: degree.
+#define SERVO_ANGLE_MAX			175
+#define SERVO_MAP_ANGLE_SCALE	64					//Angles enter a ServoMap in 1/64 degree.
+#define SERVO_MAP_SHIFT			16					//ServoMap slope and intercept are Q16.
+
+//Target of every channel, each published frame carries the whole set so a frame that
+//is skipped loses nothing.
+struct ServoFrame
+{
+	u16 count[PCA9685_CHANNELS];	//PCA9685 OFF count, 0~4095.
+	u16 mask;						//Bit n set: channel n has a target.
+	u32 epoch;						//servoOutputReleaseAll() count when staged, older frames are dropped.
+};
+
+//Angle to PCA9685 count of one servo, with its mirroring and offset baked in.
+//count = (slope * angle * SERVO_MAP_ANGLE_SCALE + intercept) >> SERVO_MAP_SHIFT, clamped to minCount~maxCount.
+struct ServoMap
+{
+	int32_t slope;
+	int32_t intercept;
+	u16 minCount;
+	u16 maxCount;
+};
+
+struct ServoOutputStats
+{
+	u32 frames;			//Frames flushed.
+	u32 framesSkipped;	//Frames dropped from a backlog.
+	u32 producerWaits;	//Ticks the motion task waited on a full ring.
+};
+
+void setupServoOutput();
+void task_ServoOutput(void *pvParameters);
+
+//Producer side, only the motion task may call these.
+//servoOutputSetAngle() calls between servoOutputBeginFrame() and servoOutputCommitFrame()
+//are published as one frame, a lone servoOutputSetAngle() is published at once.
+void servoOutputBeginFrame();
+void servoOutputSetAngle(u8 chn, float angle);
+void servoOutputSetJoint(u8 leg, u8 joint, float angle, bool isContainedOffset);
+void servoOutputSetLegs(const float (*ag)[3], bool isContainedOffset);
+void servoOutputSetLegAngles(const int16_t *angle);
+void servoOutputSetCount(u8 chn, u16 count);
+void servoOutputCommitFrame();
+void servoOutputLoadOffsets();
+const ServoFrame &servoOutputTarget();
+const float *servoOutputTargetAngles();
+
+void servoOutputReleaseAll();
+const ServoOutputStats &getServoOutputStats();
+void clearServoOutputStats();
+
+#endif
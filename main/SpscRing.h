@@ -0,0 +1,70 @@
+/**
+ * @file SpscRing.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Lock-free single-producer single-consumer ring of fixed-size slots.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _SPSCRING_h
+#define _SPSCRING_h
+
+#include <atomic>
+#include <stdint.h>
+
+#define SPSC_RING_ALIGN 32 // Cache line of the ESP32 flash / PSRAM cache.
+
+//One task pushes, one other task pops, neither ever blocks. N must be a power of two.
+//The two indices and the slots sit on separate cache lines.
+template <typename T, uint32_t N>
+class SpscRing
+{
+	static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing length must be a power of two");
+
+private:
+	alignas(SPSC_RING_ALIGN) std::atomic<uint32_t> head; //Next slot to write, producer only.
+	alignas(SPSC_RING_ALIGN) std::atomic<uint32_t> tail; //Next slot to read, consumer only.
+	alignas(SPSC_RING_ALIGN) T slots[N];
+
+public:
+	SpscRing() : head(0), tail(0) {}
+
+	bool push(const T &value)
+	{
+		uint32_t h = head.load(std::memory_order_relaxed);
+		if (h - tail.load(std::memory_order_acquire) >= N)
+		{
+			return false;
+		}
+		slots[h & (N - 1)] = value;
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T &value)
+	{
+		uint32_t t = tail.load(std::memory_order_relaxed);
+		if (t == head.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		value = slots[t & (N - 1)];
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	uint32_t length() const
+	{
+		return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+	}
+
+	bool isEmpty() const
+	{
+		return length() == 0;
+	}
+};
+
+#endif
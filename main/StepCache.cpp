@@ -0,0 +1,146 @@
+/**
+ * @file StepCache.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Small LRU cache of solved half steps, repeated steps are replayed without trig or inverse kinematics.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "StepCache.h"
+
+struct StepCacheEntry
+{
+	StepCacheKey key;
+	u32 generation; // Entries of an older generation are stale.
+	u32 lastUse;
+	StepAngles angles[STEP_CACHE_TICKS];
+};
+
+// The extra slot is the record buffer, a store swaps it with the least recently used entry.
+static StepCacheEntry *stepEntries[STEP_CACHE_ENTRIES + 1];
+static volatile u32 stepGeneration = 1;
+static u32 stepUseClock = 0;
+static StepCacheInfo stepInfo = {0, 0, 0, 0};
+
+static bool stepCacheAlloc()
+{
+	if (stepEntries[0] != NULL)
+	{
+		return true;
+	}
+	StepCacheEntry *p = (StepCacheEntry *)heap_caps_calloc(STEP_CACHE_ENTRIES + 1, sizeof(StepCacheEntry), MALLOC_CAP_SPIRAM);
+	if (p == NULL)
+	{
+		return false;
+	}
+	for (int i = 0; i <= STEP_CACHE_ENTRIES; i++)
+	{
+		stepEntries[i] = p + i;
+	}
+	return true;
+}
+
+void stepCacheMakeKey(StepCacheKey &key, const float (*start)[3], const float *stride, int ticks, u8 half, u8 spd)
+{
+	memset(&key, 0, sizeof(key));
+	for (int j = 0; j < 4; j++)
+	{
+		for (int q = 0; q < 3; q++)
+		{
+			key.start[j][q] = lroundf(start[j][q] * STEP_CACHE_SCALE);
+		}
+	}
+	for (int q = 0; q < 3; q++)
+	{
+		key.stride[q] = lroundf(stride[q] * STEP_CACHE_SCALE);
+	}
+	key.ticks = ticks;
+	key.half = half;
+	key.spd = spd;
+}
+
+/**
+ * @brief Look a half step up.
+ *
+ * @return Its angles for ticks 0~key.ticks, or NULL. Valid until the next stepCacheStore().
+ */
+const StepAngles *stepCacheFind(const StepCacheKey &key)
+{
+	if (key.ticks < STEP_CACHE_TICKS && stepCacheAlloc())
+	{
+		for (int i = 0; i < STEP_CACHE_ENTRIES; i++)
+		{
+			StepCacheEntry *e = stepEntries[i];
+			if (e->generation == stepGeneration && memcmp(&e->key, &key, sizeof(key)) == 0)
+			{
+				e->lastUse = ++stepUseClock;
+				stepInfo.hits++;
+				return e->angles;
+			}
+		}
+	}
+	stepInfo.misses++;
+	return NULL;
+}
+
+/**
+ * @brief Buffer for the angles of a half step being solved, NULL without PSRAM.
+ */
+StepAngles *stepCacheRecordBuffer()
+{
+	return stepCacheAlloc() ? stepEntries[STEP_CACHE_ENTRIES]->angles : NULL;
+}
+
+/**
+ * @brief Keep the recorded half step, in place of the least recently used or stale entry.
+ */
+void stepCacheStore(const StepCacheKey &key)
+{
+	if (!stepCacheAlloc() || key.ticks >= STEP_CACHE_TICKS)
+	{
+		return;
+	}
+	int victim = 0;
+	for (int i = 0; i < STEP_CACHE_ENTRIES; i++)
+	{
+		if (stepEntries[i]->generation != stepGeneration)
+		{
+			victim = i;
+			break;
+		}
+		if (stepEntries[i]->lastUse < stepEntries[victim]->lastUse)
+		{
+			victim = i;
+		}
+	}
+	StepCacheEntry *e = stepEntries[STEP_CACHE_ENTRIES];
+	e->key = key;
+	e->generation = stepGeneration;
+	e->lastUse = ++stepUseClock;
+	stepEntries[STEP_CACHE_ENTRIES] = stepEntries[victim];
+	stepEntries[victim] = e;
+	stepInfo.stores++;
+}
+
+/**
+ * @brief Drop every entry. Call when anything outside the key changes the solved angles:
+ * calibratePosition, servoOffset or the IK mode. Safe from any task, a half step already replaying finishes.
+ */
+void stepCacheInvalidate()
+{
+	stepGeneration++;
+	stepInfo.invalidations++;
+}
+
+const StepCacheInfo &getStepCacheInfo()
+{
+	return stepInfo;
+}
+
+void clearStepCacheInfo()
+{
+	stepInfo.hits = stepInfo.misses = stepInfo.stores = stepInfo.invalidations = 0;
+}
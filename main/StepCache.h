@@ -0,0 +1,49 @@
+/**
+ * @file StepCache.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Small LRU cache of solved half steps, repeated steps are replayed without trig or inverse kinematics.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _STEPCACHE_h
+#define _STEPCACHE_h
+
+#include "Public.h"
+
+#define STEP_CACHE_ENTRIES	8	//Half steps kept, in PSRAM.
+#define STEP_CACHE_TICKS	64	//Longest half step that can be cached, ticks 0~STEP_CACHE_TICKS-1.
+#define STEP_CACHE_SCALE	16	//Key points and strides are quantized to 1/16 mm or degree.
+
+typedef float StepAngles[4][3]; //las of one tick.
+
+//Everything a half step depends on. Zero it before filling, it is compared with memcmp().
+struct StepCacheKey
+{
+	int16_t start[4][3];	//Foot points at the first tick, the body height is in y.
+	int16_t stride[3];		//Stride x, z and spin.
+	int16_t ticks;
+	u8 half;
+	u8 spd;
+};
+
+struct StepCacheInfo
+{
+	u32 hits;
+	u32 misses;
+	u32 stores;
+	u32 invalidations;
+};
+
+void stepCacheMakeKey(StepCacheKey &key, const float (*start)[3], const float *stride, int ticks, u8 half, u8 spd);
+const StepAngles *stepCacheFind(const StepCacheKey &key);
+StepAngles *stepCacheRecordBuffer();
+void stepCacheStore(const StepCacheKey &key);
+void stepCacheInvalidate();
+const StepCacheInfo &getStepCacheInfo();
+void clearStepCacheInfo();
+
+#endif
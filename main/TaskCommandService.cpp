@@ -25,11 +25,13 @@ void task_CommandService(void *pvParameters)
 	//  while (pvParameters)
 	// while (1)
 	{
-		if (!mqInfo.isEmpty())
+		MessageHandle h;
+		if (mqInfo.out(h))
 		{
 			// Serial.print("mqInfo.length : ");
 			// Serial.print(mqInfo.length());
-			mpi.parser(mqInfo.out());
+			mpi.parser(messageText(h), strlen(messageText(h)));
+			messageFree(h);
 
 			switch (mpi.commandChar)
 			{
@@ -39,43 +41,136 @@ void task_CommandService(void *pvParameters)
 			case ID_CHECK: //
 				if (mpi.paramterCount >= 1)
 				{
-					String s = "";
 					switch (mpi.paramters[1])
 					{
 					case 0: // W#0#  get all infomation
-						s = String(ID_CHECK) + "#0#" + SW_VERSION + "#" + ROBOT_NAME + "#\n";
-						mqTx.enterForced(s);
+						mqTx.printf("%c#0#%s#%s#\n", ID_CHECK, SW_VERSION, ROBOT_NAME);
 						break;
 					case 1: // W#1#  get firmware version
-						s = String(ID_CHECK) + "#1#" + SW_VERSION + "#\n";
-						mqTx.enterForced(s);
+						mqTx.printf("%c#1#%s#\n", ID_CHECK, SW_VERSION);
 						break;
 					case 2: // W#2# get robot name
-						s = String(ID_CHECK) + "#2#" + ROBOT_NAME + "#\n";
-						mqTx.enterForced(s);
+						mqTx.printf("%c#2#%s#\n", ID_CHECK, ROBOT_NAME);
 						break;
 					case 3: // W#3# get internal code
-						s = String(ID_CHECK) + "#3#" + INTERNAL_CODE + "#\n";
-						mqTx.enterForced(s);
+						mqTx.printf("%c#3#%s#\n", ID_CHECK, INTERNAL_CODE);
 						break;
 					case 4: // W#4#FREENOVE# Check the identity of the controller
-						if (strcmp(FREENOVE_STR, mpi.inputCommandArray[2].c_str()) == 0)
+						if (strcmp(FREENOVE_STR, mpi.fields[2].data) == 0)
 						{
 							isLegalController = true;
-							s = "Controller is legal.";
+							Serial.println("Controller is legal.");
 						}
 						else
 						{ 
-							s = "Controller is llegal.";
+							Serial.println("Controller is llegal.");
 						}
 						break;
 					default:
 						break;
 					}
-					Serial.println(s);
 				}
 				break;
 
+			case ACTION_DIAGNOSTICS:
+				if (mpi.paramterCount >= 1)
+				{
+					switch (mpi.paramters[1])
+					{
+					case DIAG_SERVO_BUS: // Q#0# servo bus: channels written, channels skipped, transactions, bytes
+					{
+						const PCA9685_Stats &st = pca.getStats();
+						mqTx.printf("%c#0#%lu#%lu#%lu#%lu#\n", ACTION_DIAGNOSTICS, st.channelsWritten, st.channelsSkipped, st.transactions, st.bytes);
+						if (mpi.paramters[2] == 1)
+						{
+							pca.clearStats();
+						}
+						break;
+					}
+					case DIAG_SERVO_BUS_TIMING: // Q#1# servo bus: clock, min us, max us, mean us, nack, timeout, failed reads, short reads
+					{
+						const PCA9685_Stats &st = pca.getStats();
+						u32 meanUs = st.transactions > 0 ? st.totalUs / st.transactions : 0;
+						mqTx.printf("%c#1#%lu#%lu#%lu#%lu#%lu#%lu#%lu#%lu#\n", ACTION_DIAGNOSTICS, (unsigned long)pca.getBusClock(), st.minUs, st.maxUs, meanUs, st.nackCount, st.timeoutCount,
+									st.readFailCount, st.shortReadCount);
+						if (mpi.paramters[2] == 1)
+						{
+							pca.clearStats();
+						}
+						break;
+					}
+					case DIAG_MOTION_CLOCK: // Q#2# motion tick: policy, ticks, overruns, skipped ticks, max jitter us, mean jitter us, then max, mean and standard deviation of the last MOTION_JITTER_WINDOW ticks
+					{
+						const MotionClockStats &st = getMotionClockStats();
+						const WindowStats<u32, MOTION_JITTER_WINDOW> &jw = getMotionJitterWindow();
+						u32 meanUs = st.ticks > 0 ? st.totalJitterUs / st.ticks : 0;
+						mqTx.printf("%c#2#%u#%lu#%lu#%lu#%lu#%lu#%lu#%ld#%ld#\n", ACTION_DIAGNOSTICS, getMotionTickPolicy(), st.ticks, st.overruns, st.skippedTicks, st.maxJitterUs, meanUs,
+									jw.getMax(), lroundf(jw.getMean()), lroundf(sqrtf(jw.getVariance())));
+						if (mpi.paramters[2] == 1)
+						{
+							clearMotionClockStats();
+						}
+						break;
+					}
+					case DIAG_IK_TABLE: // Q#3# ik table: mode, points, bytes, max error of a, b, c in 1/100 degree, lookups, fallbacks
+					{
+						const IKTableInfo &st = getIKTableInfo();
+						mqTx.printf("%c#3#%u#%lu#%lu#%ld#%ld#%ld#%lu#%lu#\n", ACTION_DIAGNOSTICS, getIKMode(), st.points, st.bytes, lroundf(st.maxError[0] * 100), lroundf(st.maxError[1] * 100),
+									lroundf(st.maxError[2] * 100), st.lookups, st.fallbacks);
+						break;
+					}
+					case DIAG_STEP_CACHE: // Q#4# step cache: hits, misses, stores, invalidations
+					{
+						const StepCacheInfo &st = getStepCacheInfo();
+						mqTx.printf("%c#4#%lu#%lu#%lu#%lu#\n", ACTION_DIAGNOSTICS, st.hits, st.misses, st.stores, st.invalidations);
+						if (mpi.paramters[2] == 1)
+						{
+							clearStepCacheInfo();
+						}
+						break;
+					}
+					case DIAG_GAIT: // Q#5# gait segments: segments, handovers, restarts, max gap us, mean gap us over all segments
+					{
+						const GaitStats &st = getGaitStats();
+						u32 meanUs = st.segments > 0 ? st.totalGapUs / st.segments : 0;
+						mqTx.printf("%c#5#%lu#%lu#%lu#%lu#%lu#\n", ACTION_DIAGNOSTICS, st.segments, st.handovers, st.restarts, st.maxGapUs, meanUs);
+						if (mpi.paramters[2] == 1)
+						{
+							clearGaitStats();
+						}
+						break;
+					}
+					case DIAG_CORES: // Q#6# core 0 load %, core 1 load % since the last Q#6#, servo frames flushed, skipped, producer waits
+					{
+						u8 load[portNUM_PROCESSORS];
+						getCoreLoad(load);
+						const ServoOutputStats &st = getServoOutputStats();
+						mqTx.printf("%c#6#%u#%u#%lu#%lu#%lu#\n", ACTION_DIAGNOSTICS, load[0], load[portNUM_PROCESSORS - 1], st.frames, st.framesSkipped, st.producerWaits);
+						if (mpi.paramters[2] == 1)
+						{
+							clearServoOutputStats();
+						}
+						break;
+					}
+					case DIAG_MESSAGES: // Q#7# messages: pool blocks, in use, high water, exhausted, then high water and dropped of mqInfo and of mqTx
+					{
+						MessagePoolStats st;
+						getMessagePoolStats(st);
+						mqTx.printf("%c#7#%u#%lu#%lu#%lu#%lu#%lu#%lu#%lu#\n", ACTION_DIAGNOSTICS, MESSAGE_POOL_BLOCKS, st.inUse, st.highWater, st.exhausted,
+									(unsigned long)mqInfo.getHighWater(), (unsigned long)mqInfo.getDropped(), (unsigned long)mqTx.getHighWater(), (unsigned long)mqTx.getDropped());
+						if (mpi.paramters[2] == 1)
+						{
+							clearMessagePoolStats();
+							mqInfo.clearStats();
+							mqTx.clearStats();
+						}
+						break;
+					}
+					default:
+						break;
+					}
+				}
+				break;
 			case ACTION_RGB:
 				if (mpi.paramterCount >= 3)
 				{
@@ -118,6 +213,27 @@ void task_CommandService(void *pvParameters)
 						Serial.println("nvs_clear_all_data() ... !!!");
 						nvs_clear_all_data();
 						break;
+					case 3: // K#3#clock# save the servo bus clock, it is self-tested and applied at once.
+						if (mpi.paramterCount >= 2)
+						{
+							prefs.putUInt(KEY_SERVO_BUS_CLOCK, mpi.paramters[2]);
+							Serial.printf("Servo bus clock : %lu Hz\n", (unsigned long)pca.setBusClock(mpi.paramters[2]));
+						}
+						break;
+					case 4: // K#4#policy# save the motion tick overrun policy, 0: skip late ticks, 1: stretch the move.
+						if (mpi.paramterCount >= 2)
+						{
+							setMotionTickPolicy(mpi.paramters[2]);
+							prefs.putUChar(KEY_MOTION_TICK_POLICY, getMotionTickPolicy());
+						}
+						break;
+					case 5: // K#5#mode# save the ik mode, 0: analytic, 1: lookup table, built in the background on the first use.
+						if (mpi.paramterCount >= 2)
+						{
+							setIKMode(mpi.paramters[2]);
+							prefs.putUChar(KEY_IK_MODE, getIKMode());
+						}
+						break;
 					default:
 						break;
 					}
@@ -130,7 +246,7 @@ void task_CommandService(void *pvParameters)
 					{
 					case 0:
 						setEnableAutoWalking(false);
-						enterMessageQueue(String(ACTION_MOVE_ANY) + "#0#0#0#");
+						enterMessageQueue(ACTION_MOVE_ANY, "#0#0#0#");
 						break;
 					case 1:
 						setEnableAutoWalking(true);
@@ -150,7 +266,7 @@ void task_CommandService(void *pvParameters)
 						cs.scanWifi();
 						break;
 					case 1: // connect to router, open sta mode
-						cs.accessRouter(mpi.inputCommandArray[2], mpi.inputCommandArray[3]);
+						cs.accessRouter(mpi.fields[2].data, mpi.fields[3].data);
 						// wifi_init_sta();
 						// cs.establishCameraServer();
 						break;
@@ -19,6 +19,7 @@ TaskHandle_t taskHandle_Buzzered = NULL;
 TaskHandle_t taskHandle_Camera = NULL;
 TaskHandle_t taskHandle_AutoWalking = NULL;
 TaskHandle_t taskHandle_Secondary = NULL;
+TaskHandle_t taskHandle_Servo_Output = NULL;
 
 void startTask(uint8_t t)
 {
@@ -27,11 +28,14 @@ void startTask(uint8_t t)
     case TASK_SECONDRAY:
         xTaskCreateUniversal(loopSecondary, TSK_NAME_SECONDARY, 8192, NULL, 1, &taskHandle_Secondary, 1);
         break;
+    case TASK_SERVO_OUTPUT:
+        xTaskCreateUniversal(task_ServoOutput, TSK_NAME_SERVO_OUTPUT, 4096, NULL, 2, &taskHandle_Servo_Output, 0); // Core 0, away from loop() and the BLE work on core 1.
+        break;
     case TASK_COMMAND_SERVICE:
         xTaskCreateUniversal(task_CommandService, TSK_NAME_MOTION_SERVICE, 8192, NULL, 1, &taskHandle_Command_Service, 1); // task_MotionService uses core 1.
         break;
     case TASK_MOTION_SERVICE:
-        xTaskCreateUniversal(task_MotionService, TSK_NAME_MOTION_SERVICE, 8192, NULL, 1, &taskHandle_Motion_Service, 1); // task_MotionService uses core 1.
+        xTaskCreateUniversal(task_MotionService, TSK_NAME_MOTION_SERVICE, 8192, NULL, 2, &taskHandle_Motion_Service, 1); // Above loop() and loopSecondary(), it sleeps between ticks.
         break;
     case TASK_BATTERY_POWER_LISTRNER:
         // xTaskCreateUniversal(task_BatteryPowerListener, TSK_NAME_BATTERY_LISTENER, 8192, NULL, 1, &taskHandle_Power_Listener, 1);
@@ -123,4 +127,43 @@ void controlTask(uint8_t task, uint8_t act)
             break;
         }
     }
-}
\ No newline at end of file
+}
+/**
+ * @brief Load of each core since the previous call, from the run time of its idle task.
+ * Needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS, the loads read 0 without it.
+ *
+ * @param percent Receives portNUM_PROCESSORS values, 0~100.
+ */
+void getCoreLoad(uint8_t *percent)
+{
+    memset(percent, 0, portNUM_PROCESSORS);
+#if configGENERATE_RUN_TIME_STATS
+    static uint32_t lastTotal = 0;
+    static uint32_t lastIdle[portNUM_PROCESSORS] = {0};
+    UBaseType_t n = uxTaskGetNumberOfTasks();
+    TaskStatus_t *status = (TaskStatus_t *)malloc(n * sizeof(TaskStatus_t));
+    if (status == NULL)
+    {
+        return;
+    }
+    uint32_t total;
+    n = uxTaskGetSystemState(status, n, &total);
+    uint32_t elapsed = total - lastTotal; // Run time of each core, the counters are in esp_timer us.
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        TaskHandle_t idle = xTaskGetIdleTaskHandleForCPU(core);
+        for (UBaseType_t i = 0; i < n; i++)
+        {
+            if (status[i].xHandle == idle)
+            {
+                uint32_t idleTime = status[i].ulRunTimeCounter - lastIdle[core];
+                lastIdle[core] = status[i].ulRunTimeCounter;
+                percent[core] = elapsed > 0 && idleTime < elapsed ? 100 - (uint64_t)idleTime * 100 / elapsed : 0;
+                break;
+            }
+        }
+    }
+    lastTotal = total;
+    free(status);
+#endif
+}
@@ -29,6 +29,7 @@
 
 // Core 0:
 // core 0 : task_CameraService
+// core 0 : task_ServoOutput, and its timer interrupt
 
 #define TASK_COMMAND_SERVICE		0
 #define TASK_MOTION_SERVICE			1
@@ -38,6 +39,7 @@
 #define TASK_CAMERA_SERVICE         5
 #define TASK_AUTO_WALKING           6
 #define TASK_SECONDRAY              7
+#define TASK_SERVO_OUTPUT           8
 
 //CONFIG_FREERTOS_MAX_TASK_NAME_LEN 16
 #define TSK_NAME_COMMAND_SERVICE  "CMD_SVC"
@@ -48,6 +50,7 @@
 #define TSK_NAME_CAMERA_SERVICE	  "CAM_SVC"
 #define TSK_NAME_AUTO_WALKING	  "AUT_WK"
 #define TSK_NAME_SECONDARY	      "LOOP2"
+#define TSK_NAME_SERVO_OUTPUT	  "SRV_OUT"
 
 
 #define TASK_SUSPEND                1
@@ -59,12 +62,14 @@ void startTask(uint8_t t);
 void controlTask(uint8_t task, uint8_t act);
 
 eTaskState getTaskState(TaskHandle_t taskHandle);
+void getCoreLoad(uint8_t *percent);
 
 extern void task_CommandService(void *pvParameters);
 extern void task_MotionService(void *pvParameters);
 extern void task_CameraService(void *pvParameters);
 extern void task_AutoWalking(void *pvParameters);
 extern void loopSecondary(void *pvParameters);
+extern void task_ServoOutput(void *pvParameters);
 
 
 #endif
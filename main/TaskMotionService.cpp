@@ -11,7 +11,7 @@
 
 #include "TaskMotionService.h"
 
-MessageParser mpm = MessageParser(); // message parser motion
+MotionCommand mpm; // motion command being executed
 
 void task_MotionService(void *pvParameters)
 {
@@ -22,11 +22,21 @@ void task_MotionService(void *pvParameters)
 	// while (pvParameters)
 	while (1)
 	{
-		if (!mqMotion.isEmpty())
+		if (!isGaitActive() && !isPoseActive())
 		{
-			// Serial.print("mqMotion.length : ");
-			// Serial.print(mqMotion.length());
-			mpm.parser(mqMotion.out());
+			motionMailboxWait(portMAX_DELAY); // Sleep until a command is posted.
+		}
+		memset(&mpm, 0, sizeof(mpm));
+		if (motionMailboxTake(mpm))
+		{
+			if (mpm.commandChar != ACTION_TWIST && mpm.commandChar != ACTION_BODY_HEIGHT)
+			{
+				poseFinish();
+			}
+			if (mpm.commandChar != ACTION_MOVE_ANY)
+			{
+				gaitFinishStride(); // Other actions start from a settled pose.
+			}
 		}
 		// Serial.printf("motion(self): %d \n", getTaskState(taskHandle_Motion_Service));
 		switch (mpm.commandChar)
@@ -74,6 +84,8 @@ void task_MotionService(void *pvParameters)
 				servoOffset[n][1] = ofs[1][1] - ofs[0][1];
 				servoOffset[n][2] = ofs[1][2] - ofs[0][2];
 				prefs.put(KEY_SERVO_OFFSET, servoOffset);
+				servoOutputLoadOffsets();
+				stepCacheInvalidate();
 				Serial.println(String(ofs[0][0]) + String(" ") + String(ofs[0][1]) + String(" ") + String(ofs[0][2]));
 				Serial.println(String(ofs[1][0]) + String(" ") + String(ofs[1][1]) + String(" ") + String(ofs[1][2]));
 				Serial.println(String(ofs[1][0] - ofs[0][0]) + String(" ") + String(ofs[1][1] - ofs[0][1]) + String(" ") + String(ofs[1][2] - ofs[0][2]));
@@ -81,7 +93,7 @@ void task_MotionService(void *pvParameters)
 				break;
 			case 3:
 				setBeforeCalibrationHeight(BODY_HEIGHT_MIN);
-				pca.releaseAllServo();
+				servoOutputReleaseAll();
 				setMelodyToQueue(MELODY_BB_CLEAR_1);
 				break;
 			default:
@@ -95,7 +107,7 @@ void task_MotionService(void *pvParameters)
 				if (isRobotStanding)
 				{
 					setBodyHeight(BODY_HEIGHT_MIN);
-					pca.releaseAllServo();
+					servoOutputReleaseAll();
 					isRobotStanding = false;
 				}
 				else
@@ -111,7 +123,7 @@ void task_MotionService(void *pvParameters)
 				break;
 			case 2:
 				setBodyHeight(BODY_HEIGHT_MIN);
-				pca.releaseAllServo();
+				servoOutputReleaseAll();
 				isRobotStanding = false;
 				break;
 			default:
@@ -121,69 +133,46 @@ void task_MotionService(void *pvParameters)
 		case ACTION_BODY_HEIGHT:
 			if (mpm.paramterCount >= 1)
 			{
-				setBodyHeight(mpm.paramters[1]);
+				poseSetHeight(mpm.paramters[1]);
 			}
 			break;
-		case ACTION_TWIST:
+		case ACTION_TWIST: // E#pitch#roll#yaw[#x#y#z]#, streamed setpoints are followed tick by tick.
 			if (mpm.paramterCount >= 0)
 			{
 				resumeStanding();
-				twist_any(mpm.paramters[1], mpm.paramters[2], mpm.paramters[3]);
+				PoseSetpoint sp = {0, 0, 0, (float)mpm.paramters[2], (float)mpm.paramters[1], (float)mpm.paramters[3]};
+				if (mpm.paramterCount >= 6)
+				{
+					sp.x = mpm.paramters[4];
+					sp.y = mpm.paramters[5];
+					sp.z = mpm.paramters[6];
+				}
+				poseSetTarget(sp);
 			}
 			break;
 		case ACTION_MOVE_ANY:
 			if (mpm.paramterCount >= 3)
 			{
-				resumeStanding();
-				move_any(mpm.paramters[1], mpm.paramters[2], mpm.paramters[3], mpm.paramters[4]);
+				if (!isGaitActive())
+				{
+					resumeStanding();
+				}
+				// The gait keeps walking on its own, F#0#0#0# ends the stride on the calibration stance.
+				bool isStop = mpm.paramters[1] == 0 && mpm.paramters[2] == 0 && mpm.paramters[3] == 0;
+				gaitSetTarget(mpm.paramters[1], mpm.paramters[2], mpm.paramters[3], mpm.paramters[4], isStop ? 2 : GAIT_CONTINUOUS);
 			}
 			break;
 		case ACTION_DANCING:
 			if (mpm.paramterCount >= 0)
 			{
-				switch (mpm.paramters[1])
-				{
-				case DANCE_SAY_HELLO:
-					danceSayHello();
-					break;
-				case DANCE_PUSH_UP:
-					dancePushUp();
-					break;
-				case DANCE_STRETCH_SELF:
-					danceStretchSelf();
-					break;
-				case DANCE_TURN_AROUND:
-					danceTurnAround();
-					break;
-				case DANCE_SIT_DOWN:
-					danceSitDown();
-					break;
-				case DANCE_DANCING:
-					danceDancing();
-					break;
-				default:
-					break;
-				}
+				dance(mpm.paramters[1], mpm.paramterCount >= 2 ? mpm.paramters[2] : DANCE_MODE_PLAY);
 			}
 			break;
 		default:
-			// suspend self task.
-			controlTask(TASK_MOTION_SERVICE, TASK_SUSPEND);
 			break;
 		}
-		//Determine whether it is a one-time command, only the movement command is issued once and keeps going.
-		if (mpm.commandChar == ACTION_MOVE_ANY)
-		{
-			if (mpm.paramters[1] == 0 && mpm.paramters[2] == 0 && mpm.paramters[3] == 0)
-			{
-				mpm.clearParameters();
-			}
-		}
-		else
-		{
-			// Serial.println("Clear paramters 1 ");
-			mpm.clearParameters();
-			// vTaskDelay(30);
-		}
+		// The gait or the pose advances one tick per loop, so a new command is taken every tick.
+		gaitTick();
+		poseTick();
 	}
 }
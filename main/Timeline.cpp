@@ -0,0 +1,189 @@
+/**
+ * @file Timeline.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Keyframe timelines: servo frames recorded once per motion tick into SPIFFS and played back without inverse kinematics.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "Timeline.h"
+#include <SPIFFS.h>
+
+#define TIMELINE_READ_FRAMES 16 // Frames read from flash at a time by the player.
+
+
+static bool isTimelineMounted = false;
+static bool isTimelineRecording = false;
+static File recordFile;
+static TimelineHeader recordHeader;
+static TimelineFrame recordFrame; // Frame being held, written once it changes.
+
+bool timelineMount()
+{
+	if (!isTimelineMounted)
+	{
+		isTimelineMounted = SPIFFS.begin(true); // Formats the partition on the first boot.
+	}
+	return isTimelineMounted;
+}
+
+String timelinePath(u8 id)
+{
+	return String("/timeline_") + id + ".bin";
+}
+
+bool timelineIsValid(const TimelineHeader &hdr)
+{
+	return hdr.magic == TIMELINE_MAGIC && hdr.version == TIMELINE_VERSION && hdr.tickMs == TICK_MS && hdr.servos == TIMELINE_SERVOS && hdr.frames > 0 && hdr.ticks > 0;
+}
+
+void timelineShowFrame(const TimelineFrame &frame)
+{
+	servoOutputSetLegAngles(frame.angle);
+}
+
+/**
+ * @brief Start recording every frame published on the following motion ticks as timeline id.
+ */
+bool timelineRecordBegin(u8 id)
+{
+	if (isTimelineRecording || !timelineMount())
+	{
+		return false;
+	}
+	recordFile = SPIFFS.open(timelinePath(id).c_str(), FILE_WRITE);
+	if (!recordFile)
+	{
+		return false;
+	}
+	memset(&recordHeader, 0, sizeof(recordHeader));
+	recordHeader.magic = TIMELINE_MAGIC;
+	recordHeader.version = TIMELINE_VERSION;
+	recordHeader.tickMs = TICK_MS;
+	recordHeader.servos = TIMELINE_SERVOS;
+	memcpy(recordHeader.startPt, lastPt, sizeof(recordHeader.startPt));
+	recordFile.write((const u8 *)&recordHeader, sizeof(recordHeader)); // Rewritten with the counts at the end.
+	memset(&recordFrame, 0, sizeof(recordFrame));
+	isTimelineRecording = true;
+	return true;
+}
+
+static void timelineFlushFrame()
+{
+	if (recordFrame.hold > 0)
+	{
+		recordFile.write((const u8 *)&recordFrame, sizeof(recordFrame));
+		recordHeader.frames++;
+		recordHeader.ticks += recordFrame.hold;
+	}
+}
+
+/**
+ * @brief Called by motionTick() with the ticks that passed. The pose of those ticks is the last published frame.
+ */
+void timelineRecordTicks(int ticks)
+{
+	if (!isTimelineRecording || ticks <= 0)
+	{
+		return;
+	}
+	const float *target = servoOutputTargetAngles();
+	int16_t angle[TIMELINE_SERVOS];
+	for (u8 i = 0; i < TIMELINE_SERVOS; i++)
+	{
+		angle[i] = constrain(lroundf(target[i] * SERVO_MAP_ANGLE_SCALE), INT16_MIN, INT16_MAX);
+	}
+	if (recordFrame.hold > 0 && recordFrame.hold + ticks <= 0xFFFF && memcmp(angle, recordFrame.angle, sizeof(angle)) == 0)
+	{
+		recordFrame.hold += ticks;
+		return;
+	}
+	timelineFlushFrame();
+	memcpy(recordFrame.angle, angle, sizeof(angle));
+	recordFrame.hold = ticks;
+}
+
+bool timelineRecordEnd()
+{
+	if (!isTimelineRecording)
+	{
+		return false;
+	}
+	isTimelineRecording = false;
+	timelineFlushFrame();
+	memcpy(recordHeader.endPt, lastPt, sizeof(recordHeader.endPt));
+	recordFile.seek(0);
+	bool isOk = recordFile.write((const u8 *)&recordHeader, sizeof(recordHeader)) == sizeof(recordHeader);
+	recordFile.close();
+	Serial.printf("Timeline: %lu frames, %lu ticks\n", (unsigned long)recordHeader.frames, (unsigned long)recordHeader.ticks);
+	return isOk;
+}
+
+/**
+ * @brief Play timeline id: walk to its first pose, then publish one stored frame per motion tick.
+ *
+ * @return false if there is no valid timeline id, nothing is moved then.
+ */
+bool timelinePlay(u8 id)
+{
+	if (isTimelineRecording || !timelineMount())
+	{
+		return false;
+	}
+	File f = SPIFFS.open(timelinePath(id).c_str(), FILE_READ);
+	if (!f)
+	{
+		return false;
+	}
+	TimelineHeader hdr;
+	if (f.read((u8 *)&hdr, sizeof(hdr)) != sizeof(hdr) || !timelineIsValid(hdr))
+	{
+		f.close();
+		return false;
+	}
+	action_twist(lastPt, hdr.startPt, TIMELINE_APPROACH_SPEED);
+
+	TimelineFrame buf[TIMELINE_READ_FRAMES];
+	int bufCount = 0, bufIndex = 0;
+	int frameEnd = 0; // First tick after the frame in buf[bufIndex].
+	int lastTick = hdr.ticks - 1;
+	motionClockStart();
+	for (int t = 0; t <= lastTick; t = motionTick(t, lastTick))
+	{
+		bool isNewFrame = false;
+		while (frameEnd <= t)
+		{
+			if (++bufIndex >= bufCount)
+			{
+				bufCount = f.read((u8 *)buf, sizeof(buf)) / sizeof(TimelineFrame);
+				bufIndex = 0;
+				if (bufCount == 0)
+				{
+					break; // Truncated file, hold the last frame.
+				}
+			}
+			frameEnd += buf[bufIndex].hold;
+			isNewFrame = true;
+		}
+		if (isNewFrame && bufCount > 0)
+		{
+			timelineShowFrame(buf[bufIndex]);
+		}
+	}
+	f.close();
+	memcpy(lastPt, hdr.endPt, sizeof(hdr.endPt));
+	return true;
+}
+
+bool timelineExists(u8 id)
+{
+	return timelineMount() && SPIFFS.exists(timelinePath(id).c_str());
+}
+
+bool timelineRemove(u8 id)
+{
+	return timelineMount() && SPIFFS.remove(timelinePath(id).c_str());
+}
@@ -0,0 +1,56 @@
+/**
+ * @file Timeline.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Keyframe timelines: servo frames recorded once per motion tick into SPIFFS and played back without inverse kinematics.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _TIMELINE_h
+#define _TIMELINE_h
+
+#include "Public.h"
+
+#define TIMELINE_MAGIC			0x4C544E46	//"FNTL".
+#define TIMELINE_VERSION		3			//3: frames hold joint angles without the servo offsets.
+#define TIMELINE_SERVOS			LEG_JOINTS
+#define TIMELINE_APPROACH_SPEED	5			//Move to the first pose of a timeline, unit: mm / tick.
+
+//File layout: TimelineHeader, then header.frames TimelineFrame records. Fixed width fields, the files are
+//also written on the host, where u32 (unsigned long) is 8 bytes.
+struct TimelineHeader
+{
+	uint32_t magic;
+	u8 version;
+	u8 tickMs;						//TICK_MS of the recording, a timeline only plays at its own rate.
+	u16 servos;						//TIMELINE_SERVOS.
+	uint32_t frames;
+	uint32_t ticks;					//Sum of the holds.
+	float startPt[4][3];			//lastPt before the first frame, the player walks there first.
+	float endPt[4][3];				//lastPt after the last frame.
+};
+
+struct TimelineFrame
+{
+	u16 hold;						//Ticks the frame is shown.
+	int16_t angle[TIMELINE_SERVOS];	//Joint angles in 1/SERVO_MAP_ANGLE_SCALE degree, in the order of legTopology.
+									//Without servoOffset: the player applies the calibration of the robot it runs on.
+};
+static_assert(sizeof(TimelineHeader) == 112, "Timeline file layout");
+static_assert(sizeof(TimelineFrame) == 2 + 2 * TIMELINE_SERVOS, "Timeline file layout");
+
+bool timelineMount();
+String timelinePath(u8 id);
+bool timelineIsValid(const TimelineHeader &hdr);
+void timelineShowFrame(const TimelineFrame &frame);
+bool timelineRecordBegin(u8 id);
+void timelineRecordTicks(int ticks);
+bool timelineRecordEnd();
+bool timelinePlay(u8 id);
+bool timelineExists(u8 id);
+bool timelineRemove(u8 id);
+
+#endif
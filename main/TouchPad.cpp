@@ -97,7 +97,7 @@ void task_TouchPad(void *pvParameters)
         {
             // Serial.printf("long press ,%d\n", t3);
             setMelodyToQueue(MELODY_BEEP_1);
-            enterMessageQueue(String(ACTION_UP_DOWN) + "#0#\n");
+            enterMessageQueue(ACTION_UP_DOWN, "#0#\n");
             touchMechineStatus = 3; // wait release
         }
         if (t2 > 50) // release time > 50, press time < 700, short press, enter short pressed state
@@ -73,15 +73,15 @@ void task_AutoWalking(void *pvParameters)
 
                 dist = getSonar();
                 // bleSend(String(ACTION_ULTRASONIC) + "#" + String(dist) + "#\n");
-                mqTx.enterForced(String(ACTION_ULTRASONIC) + "#" + String(dist) + "#\n");
+                mqTx.printfForced("%c#%.2f#\n", ACTION_ULTRASONIC, dist);
                 Serial.printf("dist: %.2f\n", dist);
                 if (dist < 30)
                 {
-                    enterMessageQueue(String(ACTION_MOVE_ANY) + "#0#10#10#5#");
+                    enterMessageQueue(ACTION_MOVE_ANY, "#0#10#10#5#");
                 }
                 else
                 {
-                    enterMessageQueue(String(ACTION_MOVE_ANY) + "#0#20#0#20#");
+                    enterMessageQueue(ACTION_MOVE_ANY, "#0#20#0#20#");
                 }
                 // vTaskDelay(1000);
                 lastUpdateSonarTime = millis();
@@ -0,0 +1,127 @@
+/**
+ * @file WindowStats.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Max, min, mean and variance of the last N samples, O(1) amortized per sample.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _WINDOWSTATS_h
+#define _WINDOWSTATS_h
+
+#include <stdint.h>
+#include <type_traits>
+
+//The samples sit in a ring, the newest overwrites the oldest once N are held.
+//maxQueue holds ring slots whose values decrease from front to back, minQueue slots whose values increase,
+//so the front of each is the extreme of the window. Integer sums are exact, float sums are kept in double.
+//One task writes. A reader on another task may see a window one sample old, never a slot outside the ring.
+template <typename T, uint16_t N>
+class WindowStats
+{
+	static_assert(std::is_arithmetic<T>::value, "WindowStats needs an arithmetic type");
+	static_assert(N > 0, "WindowStats needs a window");
+
+	typedef typename std::conditional<std::is_integral<T>::value, int64_t, double>::type Sum;
+
+private:
+	T values[N];
+	uint16_t maxQueue[N], minQueue[N];
+	uint16_t pos, count;
+	uint16_t maxFront, maxLength, minFront, minLength;
+	Sum sum, sumSquares;
+
+	static uint16_t wrap(uint32_t i)
+	{
+		return i % N;
+	}
+
+public:
+	WindowStats() : values()
+	{
+		clear();
+	}
+
+	void clear()
+	{
+		pos = count = 0;
+		maxFront = maxLength = minFront = minLength = 0;
+		sum = sumSquares = 0;
+	}
+
+	void push(T value)
+	{
+		if (count == N)
+		{
+			T old = values[pos];
+			sum -= old;
+			sumSquares -= (Sum)old * old;
+			if (maxLength > 0 && maxQueue[maxFront] == pos)
+			{
+				maxFront = wrap(maxFront + 1);
+				maxLength--;
+			}
+			if (minLength > 0 && minQueue[minFront] == pos)
+			{
+				minFront = wrap(minFront + 1);
+				minLength--;
+			}
+		}
+		else
+		{
+			count++;
+		}
+		values[pos] = value;
+		sum += value;
+		sumSquares += (Sum)value * value;
+		while (maxLength > 0 && values[maxQueue[wrap(maxFront + maxLength - 1)]] <= value)
+		{
+			maxLength--;
+		}
+		maxQueue[wrap(maxFront + maxLength)] = pos;
+		maxLength++;
+		while (minLength > 0 && values[minQueue[wrap(minFront + minLength - 1)]] >= value)
+		{
+			minLength--;
+		}
+		minQueue[wrap(minFront + minLength)] = pos;
+		minLength++;
+		pos = wrap(pos + 1);
+	}
+
+	uint16_t length() const
+	{
+		return count;
+	}
+
+	T getMax() const
+	{
+		return count > 0 ? values[maxQueue[wrap(maxFront)]] : T(0);
+	}
+
+	T getMin() const
+	{
+		return count > 0 ? values[minQueue[wrap(minFront)]] : T(0);
+	}
+
+	float getMean() const
+	{
+		return count > 0 ? (float)((double)sum / count) : 0;
+	}
+
+	//Population variance of the window.
+	float getVariance() const
+	{
+		if (count == 0)
+		{
+			return 0;
+		}
+		double v = ((double)sumSquares - (double)sum * sum / count) / count;
+		return v > 0 ? (float)v : 0;
+	}
+};
+
+#endif
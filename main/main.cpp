@@ -11,8 +11,11 @@
 
 #include "Public.h"
 
-DataQueue<String> mqMotion(2); //	Motion message queue, When there are too many messages, some messages can be ignored to reduce latency.
-DataQueue<String> mqInfo(100); //  Info message queue, Important, can not ignore.
+MessageQueue<MQ_INFO_LENGTH> mqInfo; //  Info message queue, Important, can not ignore.
+extern const u8 ikTableFileStart[] asm("_binary_ik_table_bin_start"); // ik_table.bin, EMBED_FILES of main/CMakeLists.txt.
+extern const u8 ikTableFileEnd[] asm("_binary_ik_table_bin_end");
+CommandStream bleStream;             // Reset on every BLE connect and disconnect.
+CommandStream wifiStream;            // Reset when the command client is closed.
 
 void setup()
 {
@@ -20,10 +23,14 @@ void setup()
     Serial.println("\n\nProgram begin ... ");
     bleSetup();
     prefs.begin(NMSPC_STORAGE);
-    pca.begin();
+    pca.begin(prefs.getUInt(KEY_SERVO_BUS_CLOCK, PCA9685_I2C_CLOCK_DEFAULT));
     pca.releaseAllServo();
+    setupServoOutput();
+    setMotionTickPolicy(prefs.getUChar(KEY_MOTION_TICK_POLICY, TICK_POLICY_SKIP));
 
     getServoOffsetFromStorage();
+    ikTableLoad(ikTableFileStart, ikTableFileEnd - ikTableFileStart);
+    setIKMode(prefs.getUChar(KEY_IK_MODE, IK_MODE_ANALYTIC));
     getLedConfigFromStorage();
 
     cs.begin();
@@ -84,97 +91,72 @@ void loopSecondary(void *pvParameters)
 
 void serialEventRun()
 {
-    static String serialInputString = "";
+    static CommandStream serialStream;
     // Serial.println("serilaEvent ... ");
     while (Serial.available())
     {
-        char inChar = (char)Serial.read();
-        // Serial.print(inChar);
-        serialInputString += inChar;
-        if (inChar == '\n')
-        {
-            enterMessageQueue(serialInputString);
-            serialInputString = "";
-        }
+        u8 inChar = Serial.read();
+        serialStream.feed(&inChar, 1);
     }
 }
 
 void onBleReceived(BLECharacteristic *pCharacteristic)
 {
-    std::string rxValue = pCharacteristic->getValue();
-    static String bleInputString = "";
     // Serial.print("onBleReceived() function running on core: ");
     // Serial.println(xPortGetCoreID());
     // Serial.println(pcTaskGetTaskName(xTaskGetCurrentTaskHandle()));
-
-    if (rxValue.length() > 0)
-    {
-        for (int i = 0; i < rxValue.length(); i++)
-        {
-            bleInputString += rxValue[i];
-            // Serial.print(rxValue.length() );
-            // Serial.print(" ");
-            // Serial.print(rxValue[i]);
-            if (rxValue[i] == '\n')
-            {
-                enterMessageQueue(bleInputString);
-                bleInputString = "";
-            }
-        }
-    }
+    bleStream.feed(pCharacteristic->getData(), pCharacteristic->getLength()); // Straight from the characteristic, no copy.
 }
 
 void onWiFiCmdReceived(WiFiClient *client)
 {
-    static String wifiInputString = "";
     while (client->available())
     {
-        char rv[1024];
-        int ret = client->read((uint8_t *)rv, sizeof(rv));
-        for (int i = 0; i < ret; i++)
+        u8 rv[1024];
+        int ret = client->read(rv, sizeof(rv));
+        if (ret > 0)
         {
-            wifiInputString += rv[i];
-            if (rv[i] == '\n')
-            {
-                //Serial.print(wifiInputString);
-                enterMessageQueue(wifiInputString);
-                wifiInputString = "";
-            }
+            wifiStream.feed(rv, ret);
         }
     }
 }
 
 void onWiFiCmdTrasmit(WiFiClient *client)
 {
-    if (!mqTx.isEmpty())
+    MessageHandle h;
+    if (mqTx.out(h))
     {
-        client->write(mqTx.out().c_str());
+        client->write(messageText(h));
+        messageFree(h);
         // bleSend(mqTx.out());
     }
 }
 
-void enterMessageQueue(String msg)
+void enterMessageQueue(const char *msg)
 {
     //Serial.print("msg : ");
     //Serial.print(msg);
-    switch (msg.charAt(0))
+    MotionCommand cmd;
+    if (isMotionCommand(msg[0]))
     {
-    case ACTION_INSTALLATION:
-    case ACTION_CALIBRATE:
-    case ACTION_UP_DOWN:
-    case ACTION_BODY_HEIGHT:
-    case ACTION_MOVE_ANY:
-    case ACTION_TWIST:
-    case ACTION_DANCING:
-        mqMotion.enterForced(msg);
-        controlTask(TASK_MOTION_SERVICE, TASK_RESUME);
-        break;
-    default:
-        mqInfo.enterForced(msg);
-        break;
+        if (motionCommandParse(msg, cmd))
+        {
+            motionMailboxPost(cmd);
+        }
+    }
+    else
+    {
+        mqInfo.enter(msg);
     }
 }
 
+void enterMessageQueue(char commandChar, const char *params)
+{
+    char msg[MESSAGE_BLOCK_SIZE];
+    snprintf(msg, sizeof(msg), "%c%s", commandChar, params);
+    enterMessageQueue(msg);
+}
+
 // extern "C" void app_main()
 // {
 //     initArduino();
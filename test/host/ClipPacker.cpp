@@ -0,0 +1,92 @@
+/**
+ * @file ClipPacker.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Pack timeline files into an image of the motion partition on the host, for esptool. clipStorePack()
+ * itself does the packing, into flash emulated in memory, so the image is the one O#0#3# writes on the robot.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "Public.h"
+#include <SPIFFS.h>
+#include "esp_partition.h"
+#include <vector>
+
+#define CLIP_STORE_SIZE 0x40000 // The motion partition in huge_app.csv.
+
+// The partition in memory. Like NOR flash, an erase sets the bytes to 0xFF and a write only clears bits.
+static std::vector<u8> image(CLIP_STORE_SIZE, 0xFF);
+static const esp_partition_t clipPartition = {ESP_PARTITION_TYPE_DATA, CLIP_STORE_SUBTYPE, 0x3C0000, CLIP_STORE_SIZE, CLIP_STORE_LABEL, false};
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char *label)
+{
+	return type == clipPartition.type && subtype == clipPartition.subtype && strcmp(label, clipPartition.label) == 0 ? &clipPartition : NULL;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *, size_t offset, size_t, spi_flash_mmap_memory_t, const void **p, spi_flash_mmap_handle_t *)
+{
+	*p = &image[offset];
+	return ESP_OK;
+}
+
+void spi_flash_munmap(spi_flash_mmap_handle_t) {}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *, size_t offset, size_t size)
+{
+	if (offset + size > image.size())
+	{
+		return -1;
+	}
+	memset(&image[offset], 0xFF, size);
+	return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *, size_t offset, const void *data, size_t size)
+{
+	if (offset + size > image.size())
+	{
+		return -1;
+	}
+	for (size_t i = 0; i < size; i++)
+	{
+		image[offset + i] &= ((const u8 *)data)[i];
+	}
+	return ESP_OK;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 3)
+	{
+		printf("usage: ClipPacker <timeline directory> <image>\n");
+		return 2;
+	}
+	SPIFFS.hostDir = argv[1];
+	int count = clipStorePack();
+	if (count < 0)
+	{
+		printf("ClipPacker: cannot pack %s\n", argv[1]);
+		return 1;
+	}
+	// The robot only plays a clip that passes clipExists(), a timeline that is invalid or did not fit is reported.
+	bool isOk = true;
+	for (u8 id = 0; id < CLIP_STORE_MAX; id++)
+	{
+		if (timelineExists(id) && !clipExists(id))
+		{
+			printf("ClipPacker: %s is not a playable clip\n", timelinePath(id).c_str());
+			isOk = false;
+		}
+	}
+	FILE *f = fopen(argv[2], "wb");
+	if (f == NULL || fwrite(image.data(), 1, image.size(), f) != image.size() || fclose(f) != 0)
+	{
+		printf("ClipPacker: cannot write %s\n", argv[2]);
+		return 1;
+	}
+	printf("%s: %d clips, flash it with esptool.py write_flash 0x%X %s\n", argv[2], count, (unsigned)clipPartition.address, argv[2]);
+	return isOk ? 0 : 1;
+}
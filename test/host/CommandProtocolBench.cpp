@@ -0,0 +1,119 @@
+/**
+ * @file CommandProtocolBench.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Cost of a walk command from received bytes to the motion mailbox, sent as a text line and as a binary frame.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "CommandProtocol.h"
+#include <new>
+#include <stdlib.h>
+#include <vector>
+
+TaskHandle_t taskHandle_Motion_Service = NULL;
+
+static unsigned long allocationCount = 0;
+
+void *operator new(size_t size)
+{
+	allocationCount++;
+	void *p = malloc(size ? size : 1);
+	if (p == NULL)
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+static unsigned long textLines = 0;
+
+// As main.cpp: a motion line is parsed and posted, the others would go to mqInfo.
+void enterMessageQueue(const char *msg)
+{
+	MotionCommand cmd;
+	if (isMotionCommand(msg[0]) && motionCommandParse(msg, cmd))
+	{
+		motionMailboxPost(cmd);
+	}
+	else
+	{
+		textLines++;
+	}
+}
+
+static void addFrame(std::vector<u8> &stream, char type, const void *payload, u8 length)
+{
+	size_t start = stream.size();
+	stream.push_back(PROTOCOL_SYNC);
+	stream.push_back(PROTOCOL_VERSION);
+	stream.push_back(type);
+	stream.push_back(length);
+	stream.insert(stream.end(), (const u8 *)payload, (const u8 *)payload + length);
+	u16 crc = protocolCrc16(&stream[start + 1], 3 + length);
+	stream.push_back(crc & 0xFF);
+	stream.push_back(crc >> 8);
+}
+
+//Feed the stream as BLE writes of one message each, then check the mailbox holds the last walk command.
+static void timeStream(const char *name, const std::vector<u8> &stream, const std::vector<size_t> &ends, const ProtocolMoveAny &last)
+{
+	const int rounds = 2000;
+	CommandStream cs;
+	MotionCommand cmd;
+	unsigned long allocations = allocationCount;
+	double t = hostNow();
+	for (int r = 0; r < rounds; r++)
+	{
+		size_t start = 0;
+		for (size_t i = 0; i < ends.size(); i++)
+		{
+			cs.feed(&stream[start], ends[i] - start);
+			start = ends[i];
+		}
+	}
+	t = hostNow() - t;
+	double messages = (double)rounds * ends.size();
+	printf("%-7s %7.1f ns/message %5.1f bytes/message %5.2f allocations/message\n", name, t * 1e9 / messages,
+		   (double)stream.size() / ends.size(), (allocationCount - allocations) / messages);
+	CHECK(allocationCount == allocations);
+	CHECK(textLines == 0);
+	CHECK(motionMailboxTake(cmd) && !motionMailboxTake(cmd));
+	CHECK(cmd.commandChar == ACTION_MOVE_ANY && cmd.paramterCount == 4);
+	CHECK(cmd.paramters[1] == last.alpha && cmd.paramters[2] == last.stepLength && cmd.paramters[3] == last.gama && cmd.paramters[4] == last.speed);
+}
+
+int main()
+{
+	const size_t messages = 200;
+	std::vector<u8> lines, frames;
+	std::vector<size_t> lineEnds, frameEnds;
+	ProtocolMoveAny move;
+	for (size_t i = 0; i < messages; i++)
+	{
+		move = {(int16_t)(i % 360 - 180), (int16_t)(i % 36), (int16_t)(i % 40 - 20), (u8)(i % 10)};
+		char line[64];
+		int n = snprintf(line, sizeof(line), "F#%d#%d#%d#%d#\n", move.alpha, move.stepLength, move.gama, move.speed);
+		lines.insert(lines.end(), line, line + n);
+		lineEnds.push_back(lines.size());
+		addFrame(frames, ACTION_MOVE_ANY, &move, sizeof(move));
+		frameEnds.push_back(frames.size());
+	}
+	timeStream("lines", lines, lineEnds, move);
+	timeStream("frames", frames, frameEnds, move);
+	return hostTestResult();
+}
@@ -0,0 +1,222 @@
+/**
+ * @file CommandProtocolTest.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief CommandStream on the host: the crc, frames and lines split anywhere, malformed frames and reset().
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "CommandProtocol.h"
+#include <string>
+#include <vector>
+
+// What the stream handed on, in order: text lines as they are, motion commands as "F 1 2 3".
+static std::vector<std::string> received;
+
+void enterMessageQueue(const char *msg)
+{
+	received.push_back(msg);
+}
+
+bool isMotionCommand(char commandChar)
+{
+	return strchr("ABEFJLO", commandChar) != NULL && commandChar != 0;
+}
+
+void motionMailboxPost(const MotionCommand &cmd)
+{
+	std::string s(1, cmd.commandChar);
+	for (int i = 1; i <= cmd.paramterCount; i++)
+	{
+		s += " " + std::to_string(cmd.paramters[i]);
+	}
+	received.push_back(s);
+}
+
+static void addText(std::vector<u8> &stream, const char *text)
+{
+	stream.insert(stream.end(), text, text + strlen(text));
+}
+
+static void addFrame(std::vector<u8> &stream, char type, const void *payload, u8 length, u8 version = PROTOCOL_VERSION)
+{
+	size_t start = stream.size();
+	stream.push_back(PROTOCOL_SYNC);
+	stream.push_back(version);
+	stream.push_back(type);
+	stream.push_back(length);
+	stream.insert(stream.end(), (const u8 *)payload, (const u8 *)payload + length);
+	u16 crc = protocolCrc16(&stream[start + 1], 3 + length);
+	stream.push_back(crc & 0xFF);
+	stream.push_back(crc >> 8);
+}
+
+//Feed the stream in chunks of chunk bytes, return what came out.
+static std::vector<std::string> feedStream(const std::vector<u8> &stream, size_t chunk)
+{
+	CommandStream cs;
+	received.clear();
+	for (size_t i = 0; i < stream.size(); i += chunk)
+	{
+		cs.feed(&stream[i], stream.size() - i < chunk ? stream.size() - i : chunk);
+	}
+	return received;
+}
+
+//The bitwise form the table was built from.
+static u16 crc16Bitwise(const u8 *data, size_t length)
+{
+	u16 crc = 0xFFFF;
+	for (size_t i = 0; i < length; i++)
+	{
+		crc ^= (u16)data[i] << 8;
+		for (u8 k = 0; k < 8; k++)
+		{
+			crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+static void checkCrc()
+{
+	CHECK(protocolCrc16((const u8 *)"123456789", 9) == 0x29B1);
+	CHECK(protocolCrc16((const u8 *)"", 0) == 0xFFFF);
+	u16 crc = protocolCrc16((const u8 *)"1234", 4);
+	CHECK(protocolCrc16((const u8 *)"56789", 5, crc) == 0x29B1);
+	u8 data[PROTOCOL_PAYLOAD_MAX + 3];
+	srand(2026);
+	for (int n = 0; n < 1000; n++)
+	{
+		size_t length = rand() % sizeof(data);
+		for (size_t i = 0; i < length; i++)
+		{
+			data[i] = rand();
+		}
+		CHECK(protocolCrc16(data, length) == crc16Bitwise(data, length));
+	}
+}
+
+static void checkFrames()
+{
+	std::vector<u8> stream;
+	addText(stream, "F#0#20#0#5#\n");
+	ProtocolMoveAny move = {-30, 25, -5, 6};
+	addFrame(stream, ACTION_MOVE_ANY, &move, sizeof(move));
+	ProtocolNetwork network = {1, "home", "secret"};
+	addFrame(stream, ACTION_NETWORK, &network, sizeof(network));
+	ProtocolSetNvs nvs = {3, 400000};
+	addFrame(stream, ACTION_SET_NVS, &nvs, sizeof(nvs));
+	ProtocolTwist twist = {-12, 8, 15, -10, 5, 20};
+	addFrame(stream, ACTION_TWIST, &twist, sizeof(twist));
+	addFrame(stream, ACTION_GET_VOLTAGE, NULL, 0);
+	addText(stream, "Q#6#\n");
+
+	const std::vector<std::string> expected = {
+		"F#0#20#0#5#\n", "F -30 25 -5 6", "N#1#home#secret#\n", "K#3#400000#\n", "E -12 8 15 -10 5 20", "I#\n", "Q#6#\n"};
+	for (size_t chunk = 1; chunk <= stream.size(); chunk++)
+	{
+		CHECK(feedStream(stream, chunk) == expected);
+	}
+}
+
+//Each malformed frame sits between two lines, only the lines may come out.
+static void checkMalformed(const char *name, const std::vector<u8> &frame)
+{
+	std::vector<u8> stream;
+	addText(stream, "Q#1#\n");
+	stream.insert(stream.end(), frame.begin(), frame.end());
+	addText(stream, "T#\n");
+	const std::vector<std::string> expected = {"Q#1#\n", "T#\n"};
+	for (size_t chunk = 1; chunk <= stream.size(); chunk++)
+	{
+		if (feedStream(stream, chunk) != expected)
+		{
+			printf("%s frame, chunk %u:", name, (unsigned)chunk);
+			for (size_t i = 0; i < received.size(); i++)
+			{
+				printf(" \"%s\"", received[i].c_str());
+			}
+			printf("\n");
+			CHECK(false);
+			return;
+		}
+	}
+}
+
+static void checkMalformedFrames()
+{
+	ProtocolSetNvs nvs = {3, 0x230A23}; // '#', '\n', '#' in the payload.
+	std::vector<u8> frame;
+
+	addFrame(frame, ACTION_SET_NVS, &nvs, sizeof(nvs));
+	frame[6] ^= 1;
+	checkMalformed("bad payload", frame);
+
+	frame.clear();
+	addFrame(frame, ACTION_SET_NVS, &nvs, sizeof(nvs));
+	frame.back() ^= 0x80;
+	checkMalformed("bad crc", frame);
+
+	frame.clear();
+	addFrame(frame, ACTION_SET_NVS, &nvs, sizeof(nvs), PROTOCOL_VERSION + 1);
+	checkMalformed("next version", frame);
+
+	u8 longPayload[PROTOCOL_PAYLOAD_MAX + 20];
+	memset(longPayload, '\n', sizeof(longPayload));
+	frame.clear();
+	addFrame(frame, ACTION_NETWORK, longPayload, sizeof(longPayload));
+	checkMalformed("too long", frame);
+
+	frame.clear();
+	addFrame(frame, ACTION_SET_NVS, &nvs, sizeof(nvs) - 1);
+	checkMalformed("short layout", frame);
+
+	frame.clear();
+	addFrame(frame, 'Z', &nvs, sizeof(nvs));
+	checkMalformed("unknown type", frame);
+}
+
+//A client that left mid frame or mid line: after reset() the next client's first line comes through.
+static void checkReset()
+{
+	ProtocolNetwork network = {1, "home", "secret"};
+	std::vector<u8> frame;
+	addFrame(frame, ACTION_NETWORK, &network, sizeof(network));
+	const u8 *cuts[] = {(const u8 *)"F#10#2", &frame[0]};
+	size_t cutLengths[] = {6, 20};
+	for (u8 i = 0; i < 2; i++)
+	{
+		CommandStream cs;
+		received.clear();
+		cs.feed(cuts[i], cutLengths[i]);
+		cs.reset();
+		cs.feed((const u8 *)"T#\n", 3);
+		CHECK(received.size() == 1 && received[0] == "T#\n");
+	}
+}
+
+static void checkLongLine()
+{
+	std::string line = "N#1#" + std::string(MESSAGE_LENGTH_MAX, 'x') + "#\n";
+	std::vector<u8> stream;
+	addText(stream, line.c_str());
+	addText(stream, "T#\n");
+	std::vector<std::string> out = feedStream(stream, 16);
+	CHECK(out.size() == 2);
+	CHECK(out.size() == 2 && out[0].size() == MESSAGE_LENGTH_MAX + 1 && out[0].back() == '\n' && out[1] == "T#\n");
+}
+
+int main()
+{
+	checkCrc();
+	checkFrames();
+	checkMalformedFrames();
+	checkReset();
+	checkLongLine();
+	return hostTestResult();
+}
@@ -0,0 +1,174 @@
+/**
+ * @file DanceCompiler.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Compile the dance routines into v3 timeline files on the host: each routine runs with the firmware
+ * recorder on, against a stubbed servo output, on a motion clock that never misses a tick.
+ * Every file is then played back and checked frame by frame against the routine.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "Public.h"
+#include <SPIFFS.h>
+#include <vector>
+
+PreferencesPro prefs;
+
+PreferencesPro::PreferencesPro() {}
+PreferencesPro::~PreferencesPro() {}
+size_t Preferences::putBytes(const char *, const void *, size_t) { return 0; }
+size_t Preferences::getBytes(const char *, void *, size_t) { return 0; }
+size_t Preferences::getBytesLength(const char *) { return 0; }
+
+Freenove_PCA9685::Freenove_PCA9685(u8 i2c_addr) { address = i2c_addr; }
+
+bool clipPlay(u8) { return false; }
+bool clipRemove(u8) { return false; }
+int clipStorePack() { return 0; }
+
+// The servo output, reduced to the joint angles a frame leaves staged. The host has no calibration, servoOffset is 0.
+static float targetAngle[LEG_JOINTS];
+
+void servoOutputBeginFrame() {}
+void servoOutputCommitFrame() {}
+void servoOutputLoadOffsets() {}
+
+void servoOutputSetAngle(u8 chn, float angle)
+{
+	for (u8 n = 0; n < LEG_JOINTS; n++)
+	{
+		if (legChannel(n) == chn)
+		{
+			targetAngle[n] = legTopology.joint[n / 3][n % 3].isMirrored ? 180 - angle : angle;
+		}
+	}
+}
+
+void servoOutputSetJoint(u8 leg, u8 joint, float angle, bool)
+{
+	targetAngle[leg * 3 + joint] = angle;
+}
+
+void servoOutputSetLegs(const float (*ag)[3], bool)
+{
+	memcpy(targetAngle, ag, sizeof(targetAngle));
+}
+
+void servoOutputSetLegAngles(const int16_t *angle)
+{
+	for (u8 n = 0; n < LEG_JOINTS; n++)
+	{
+		targetAngle[n] = angle[n] * (1.0f / SERVO_MAP_ANGLE_SCALE);
+	}
+}
+
+const float *servoOutputTargetAngles()
+{
+	return targetAngle;
+}
+
+struct TickAngles
+{
+	int16_t angle[TIMELINE_SERVOS];
+};
+
+static bool isCapturing = false;
+static std::vector<TickAngles> captured; // The servo frame of every tick, quantised as the recorder does.
+
+// The host motion clock: no waiting and no skipped tick, so a timeline holds every tick of its routine.
+void motionClockStart() {}
+
+int motionTick(int t, int)
+{
+	if (isCapturing)
+	{
+		TickAngles tick;
+		const float *target = servoOutputTargetAngles();
+		for (u8 i = 0; i < TIMELINE_SERVOS; i++)
+		{
+			tick.angle[i] = constrain(lroundf(target[i] * SERVO_MAP_ANGLE_SCALE), INT16_MIN, INT16_MAX);
+		}
+		captured.push_back(tick);
+	}
+	timelineRecordTicks(1);
+	return t + 1;
+}
+
+void motionPause(u32 ms)
+{
+	int lastTick = ms / TICK_MS - 1;
+	for (int t = 0; t <= lastTick; t = motionTick(t, lastTick))
+	{
+	}
+}
+
+static std::vector<TickAngles> runDance(u8 id, u8 mode)
+{
+	standUp();
+	captured.clear();
+	isCapturing = true;
+	dance(id, mode);
+	isCapturing = false;
+	return captured;
+}
+
+static bool isSameTicks(const std::vector<TickAngles> &a, size_t from, const std::vector<TickAngles> &b)
+{
+	return a.size() - from == b.size() && memcmp(&a[from], &b[0], b.size() * sizeof(TickAngles)) == 0;
+}
+
+//Record dance id, then check the file: valid, its frames expand to the ticks of the routine, and it plays them back.
+static bool compileDance(u8 id, const char *name)
+{
+	std::vector<TickAngles> ticks = runDance(id, DANCE_MODE_RECORD);
+	File f = SPIFFS.open(timelinePath(id).c_str(), FILE_READ);
+	TimelineHeader hdr;
+	if (!f || f.read((u8 *)&hdr, sizeof(hdr)) != sizeof(hdr) || !timelineIsValid(hdr) || hdr.ticks != ticks.size())
+	{
+		printf("%s: no valid timeline\n", name);
+		f.close();
+		return false;
+	}
+	std::vector<TickAngles> expanded;
+	TimelineFrame frame;
+	while (f.read((u8 *)&frame, sizeof(frame)) == sizeof(frame))
+	{
+		expanded.insert(expanded.end(), frame.hold, *(const TickAngles *)frame.angle);
+	}
+	size_t bytes = f.size();
+	f.close();
+	if (!isSameTicks(expanded, 0, ticks))
+	{
+		printf("%s: the frames differ from the routine\n", name);
+		return false;
+	}
+	std::vector<TickAngles> played = runDance(id, DANCE_MODE_PLAY); // The walk to the first pose, then the timeline.
+	if (played.size() < ticks.size() || !isSameTicks(played, played.size() - ticks.size(), ticks))
+	{
+		printf("%s: the playback differs from the routine\n", name);
+		return false;
+	}
+	printf("%-28s %5lu frames %6lu ticks %7lu bytes\n", timelinePath(id).c_str(), (unsigned long)hdr.frames, (unsigned long)hdr.ticks,
+		   (unsigned long)bytes);
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 2)
+	{
+		printf("usage: DanceCompiler <directory>\n");
+		return 2;
+	}
+	SPIFFS.hostDir = argv[1];
+	const char *names[DANCE_COUNT] = {"danceSayHello", "dancePushUp", "danceStretchSelf", "danceTurnAround", "danceSitDown", "danceDancing"};
+	bool isOk = true;
+	for (u8 id = 0; id < DANCE_COUNT; id++)
+	{
+		isOk = compileDance(id, names[id]) && isOk;
+	}
+	return isOk ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file FastMathTest.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief FastMath.h against double-precision libm: the error bounds of its header, and the time per call.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "FastMath.h"
+
+static double maxError(double e, double fast, double exact)
+{
+	return fmax(e, fabs(fast - exact));
+}
+
+static void checkAccuracy()
+{
+	double eSin = 0, eDeg = 0, eAtan = 0, eAsin = 0, eAcos = 0;
+	for (double x = -1000; x <= 1000; x += 0.0007)
+	{
+		float f = x;
+		eSin = maxError(eSin, fastSin(f), sin((double)f));
+		eSin = maxError(eSin, fastCos(f), cos((double)f));
+	}
+	for (double x = -3600; x <= 3600; x += 0.0013)
+	{
+		float f = x;
+		eDeg = maxError(eDeg, fastSinDeg(f), sin(f * M_PI / 180));
+		eDeg = maxError(eDeg, fastCosDeg(f), cos(f * M_PI / 180));
+	}
+	for (double y = -200; y <= 200; y += 0.37)
+	{
+		for (double x = -200; x <= 200; x += 0.41)
+		{
+			float fy = y, fx = x;
+			eAtan = maxError(eAtan, fastAtan2(fy, fx), atan2((double)fy, (double)fx));
+		}
+	}
+	for (double x = -1; x <= 1; x += 1e-6)
+	{
+		float f = x;
+		eAsin = maxError(eAsin, fastAsin(f), asin((double)f));
+		eAcos = maxError(eAcos, fastAcos(f), acos((double)f));
+	}
+	printf("max error: sin/cos %.2e, sinDeg/cosDeg %.2e, atan2 %.2e, asin %.2e, acos %.2e\n", eSin, eDeg, eAtan, eAsin, eAcos);
+	// The table in the FastMath.h header, rounded up in its last digit.
+	CHECK(eSin <= 1.05e-7);
+	CHECK(eDeg <= 1.05e-7);
+	CHECK(eAtan <= 3.15e-7);
+	CHECK(eAsin <= 4.45e-7);
+	CHECK(eAcos <= 4.45e-7);
+}
+
+static volatile float sink; //Keeps the timed results alive.
+
+template <typename F>
+static double timeCall(F f)
+{
+	const int calls = 4000000;
+	float sum = 0;
+	double t0 = hostNow();
+	for (int i = 0; i < calls; i++)
+	{
+		sum += f(i * 4.5e-7f - 0.9f);
+	}
+	sink = sum;
+	return (hostNow() - t0) * 1e9 / calls;
+}
+
+static void timeCalls()
+{
+	printf("ns per call, fast / libm float / libm double:\n");
+	printf("sin   %.2f / %.2f / %.2f\n", timeCall([](float x) { return fastSin(x); }), timeCall([](float x) { return sinf(x); }),
+		   timeCall([](float x) { return (float)sin(x); }));
+	printf("atan2 %.2f / %.2f / %.2f\n", timeCall([](float x) { return fastAtan2(x, 0.3f); }), timeCall([](float x) { return atan2f(x, 0.3f); }),
+		   timeCall([](float x) { return (float)atan2(x, 0.3); }));
+	printf("asin  %.2f / %.2f / %.2f\n", timeCall([](float x) { return fastAsin(x); }), timeCall([](float x) { return asinf(x); }),
+		   timeCall([](float x) { return (float)asin(x); }));
+	printf("acos  %.2f / %.2f / %.2f\n", timeCall([](float x) { return fastAcos(x); }), timeCall([](float x) { return acosf(x); }),
+		   timeCall([](float x) { return (float)acos(x); }));
+}
+
+int main()
+{
+	checkAccuracy();
+	timeCalls();
+	return hostTestResult();
+}
@@ -0,0 +1,47 @@
+/**
+ * @file HostTest.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Minimal checks for the host tests: each test is a program, ctest reads its exit code.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _HOSTTEST_h
+#define _HOSTTEST_h
+
+#include <stdio.h>
+#include <chrono>
+
+static int hostTestFailures = 0;
+
+#define CHECK(cond)                                                          \
+	do                                                                       \
+	{                                                                        \
+		if (!(cond))                                                         \
+		{                                                                    \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+			hostTestFailures++;                                              \
+		}                                                                    \
+	} while (0)
+
+//Exit code of main(): 0 when every CHECK held.
+static inline int hostTestResult()
+{
+	if (hostTestFailures == 0)
+	{
+		printf("PASS\n");
+		return 0;
+	}
+	printf("FAIL: %d checks\n", hostTestFailures);
+	return 1;
+}
+
+static inline double hostNow()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif
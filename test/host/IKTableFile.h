@@ -0,0 +1,43 @@
+/**
+ * @file IKTableFile.h
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief The bytes of ik_table.bin, shared by IKTableGen and IKTableTest so both write the same file.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#ifndef _IKTABLEFILE_h
+#define _IKTABLEFILE_h
+
+#include "Public.h"
+#include <vector>
+
+//Fill the table with the analytic solver and put the header in front. IK_MODE_ANALYTIC while it runs.
+static inline std::vector<u8> ikTableFileBytes()
+{
+	u8 mode = getIKMode();
+	setIKMode(IK_MODE_ANALYTIC);
+	std::vector<IKEntry> table(IK_TABLE_POINTS);
+	IKTableFileHeader hdr;
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.magic = IK_TABLE_MAGIC;
+	hdr.xMin = IK_TABLE_X_MIN;
+	hdr.xMax = IK_TABLE_X_MAX;
+	hdr.yMin = IK_TABLE_Y_MIN;
+	hdr.yMax = IK_TABLE_Y_MAX;
+	hdr.zMin = IK_TABLE_Z_MIN;
+	hdr.zMax = IK_TABLE_Z_MAX;
+	hdr.step = IK_TABLE_STEP;
+	hdr.scale = IK_TABLE_SCALE;
+	ikTableFill(table.data(), hdr.maxError);
+	setIKMode(mode);
+
+	std::vector<u8> bytes((const u8 *)&hdr, (const u8 *)(&hdr + 1));
+	bytes.insert(bytes.end(), (const u8 *)table.data(), (const u8 *)(table.data() + table.size()));
+	return bytes;
+}
+
+#endif
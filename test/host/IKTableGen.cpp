@@ -0,0 +1,39 @@
+/**
+ * @file IKTableGen.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Write main/ik_table.bin, the IK table the firmware embeds. Run after changing the kinematics or the grid:
+ * cmake --build build --target ik_table
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "IKTableFile.h"
+
+// No tasks on the host, the table is filled on the caller.
+BaseType_t xTaskCreateUniversal(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *, BaseType_t) { return pdFAIL; }
+void vTaskDelete(TaskHandle_t) {}
+TaskHandle_t xTaskGetCurrentTaskHandle() { return NULL; }
+
+int main(int argc, char **argv)
+{
+	if (argc != 2)
+	{
+		printf("usage: IKTableGen <ik_table.bin>\n");
+		return 2;
+	}
+	std::vector<u8> bytes = ikTableFileBytes();
+	FILE *f = fopen(argv[1], "wb");
+	if (f == NULL || fwrite(bytes.data(), 1, bytes.size(), f) != bytes.size() || fclose(f) != 0)
+	{
+		printf("IKTableGen: cannot write %s\n", argv[1]);
+		return 1;
+	}
+	IKTableFileHeader hdr;
+	memcpy(&hdr, bytes.data(), sizeof(hdr));
+	printf("%s: %u points, %u bytes, max error %.3f %.3f %.3f deg\n", argv[1], (unsigned)IK_TABLE_POINTS, (unsigned)bytes.size(),
+		   hdr.maxError[0], hdr.maxError[1], hdr.maxError[2]);
+	return 0;
+}
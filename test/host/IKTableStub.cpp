@@ -0,0 +1,14 @@
+/**
+ * @file IKTableStub.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief No table, for the host programs that link Motion.cpp without IKTable.cpp: every point is solved analytically.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "Public.h"
+
+bool ikTableLookup(float, float, float, float *, float *, float *) { return false; }
@@ -0,0 +1,149 @@
+/**
+ * @file IKTableTest.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief The embedded IK table: generated reproducibly, loaded without a build, within its error bounds, and
+ * falling back to cooToA() at and beyond DR.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "IKTableFile.h"
+#include <random>
+
+static int taskCreates = 0;
+
+BaseType_t xTaskCreateUniversal(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *, BaseType_t)
+{
+	taskCreates++;
+	return pdFAIL;
+}
+void vTaskDelete(TaskHandle_t) {}
+TaskHandle_t xTaskGetCurrentTaskHandle() { return NULL; }
+
+static std::vector<u8> readFile(const char *path)
+{
+	std::vector<u8> bytes;
+	FILE *f = fopen(path, "rb");
+	if (f != NULL)
+	{
+		u8 buffer[4096];
+		size_t n;
+		while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0)
+		{
+			bytes.insert(bytes.end(), buffer, buffer + n);
+		}
+		fclose(f);
+	}
+	return bytes;
+}
+
+static void solve(bool isTable, float x, float y, float z, float *abc)
+{
+	setIKMode(isTable ? IK_MODE_TABLE : IK_MODE_ANALYTIC);
+	cooToA(x, y, z, abc);
+}
+
+//Largest |table - cooToA()| at every cell centre the table answers, against the bounds of the committed file.
+static void checkCellCentres()
+{
+	float maxError[3] = {0, 0, 0};
+	for (int i = 0; i < IK_TABLE_NX - 1; i++)
+	{
+		for (int j = 0; j < IK_TABLE_NY - 1; j++)
+		{
+			for (int k = 0; k < IK_TABLE_NZ - 1; k++)
+			{
+				float x = IK_TABLE_X_MIN + (i + 0.5f) * IK_TABLE_STEP, y = IK_TABLE_Y_MIN + (j + 0.5f) * IK_TABLE_STEP, z = IK_TABLE_Z_MIN + (k + 0.5f) * IK_TABLE_STEP;
+				float exact[3], lut[3];
+				solve(false, x, y, z, exact);
+				setIKMode(IK_MODE_TABLE);
+				if (!ikTableLookup(x, y, z, &lut[0], &lut[1], &lut[2]))
+				{
+					continue;
+				}
+				for (int q = 0; q < 3; q++)
+				{
+					maxError[q] = fmaxf(maxError[q], fabsf(lut[q] - exact[q]));
+				}
+			}
+		}
+	}
+	const IKTableInfo &info = getIKTableInfo();
+	printf("max error at cell centres: %.3f %.3f %.3f deg\n", maxError[0], maxError[1], maxError[2]);
+	for (int q = 0; q < 3; q++)
+	{
+		CHECK(maxError[q] == info.maxError[q]);
+	}
+	CHECK(maxError[0] < 0.01f);
+	CHECK(maxError[1] < 0.15f);
+	CHECK(maxError[2] < 0.2f);
+}
+
+//Feet beyond DR, and the same feet pulled onto DR: never interpolated, cooToA() solves them exactly.
+static void checkFallback()
+{
+	std::mt19937 rng(2026);
+	std::uniform_real_distribution<float> ux(IK_TABLE_X_MIN, IK_TABLE_X_MAX), uy(IK_TABLE_Y_MIN, IK_TABLE_Y_MAX), uz(IK_TABLE_Z_MIN, IK_TABLE_Z_MAX);
+	int beyond = 0, interpolated = 0;
+	for (int n = 0; n < 200000 && beyond < 2000; n++)
+	{
+		float p[3] = {ux(rng), uy(rng), uz(rng)};
+		if (isInActiveRadius(p[0], p[1], p[2]))
+		{
+			continue;
+		}
+		beyond++;
+		float onDR[3] = {p[0], p[1], p[2]};
+		clampFootPoint(onDR);
+		const float *feet[2] = {p, onDR};
+		for (int f = 0; f < 2; f++)
+		{
+			float lut[3], exact[3], table[3];
+			setIKMode(IK_MODE_TABLE);
+			interpolated += ikTableLookup(feet[f][0], feet[f][1], feet[f][2], &lut[0], &lut[1], &lut[2]);
+			solve(true, feet[f][0], feet[f][1], feet[f][2], table);
+			solve(false, feet[f][0], feet[f][1], feet[f][2], exact);
+			CHECK(memcmp(table, exact, sizeof(table)) == 0);
+		}
+	}
+	CHECK(beyond > 1000);
+	CHECK(interpolated == 0);
+
+	u32 fallbacks = getIKTableInfo().fallbacks;
+	float lut[3];
+	setIKMode(IK_MODE_TABLE);
+	CHECK(!ikTableLookup(0, IK_TABLE_Y_MAX + 1, 0, &lut[0], &lut[1], &lut[2])); // Outside the grid.
+	CHECK(getIKTableInfo().fallbacks == fallbacks + 1);
+}
+
+int main()
+{
+	std::vector<u8> file = readFile(IK_TABLE_FILE);
+	std::vector<u8> fresh = ikTableFileBytes();
+	CHECK(file == fresh); // Else regenerate: cmake --build build --target ik_table
+	if (file.empty())
+	{
+		return hostTestResult();
+	}
+
+	std::vector<u8> shifted(file.size() + 1); // Entries not 2-byte aligned are copied.
+	memcpy(&shifted[1], file.data(), file.size());
+	file[0] ^= 1;
+	CHECK(!ikTableLookup(0, 100, 0, NULL, NULL, NULL));
+	CHECK(!ikTableLoad(file.data(), file.size())); // Bad magic.
+	file[0] ^= 1;
+	CHECK(!ikTableLoad(file.data(), file.size() - 1));
+	CHECK(ikTableLoad(&shifted[1], shifted.size() - 1));
+	CHECK(!ikTableLoad(file.data(), file.size())); // Already loaded.
+	setIKMode(IK_MODE_TABLE);
+	CHECK(taskCreates == 0);
+	CHECK(getIKTableInfo().buildMs == 0);
+
+	checkCellCentres();
+	checkFallback();
+	return hostTestResult();
+}
@@ -0,0 +1,180 @@
+/**
+ * @file KinematicsTest.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief cooToA() against the former double-precision path, and the aToCoo() / clampFootPoint() round trip.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "Public.h"
+
+#define L1 23.0
+#define L2 55.0
+#define L3 59.0
+#define DR 100.0
+
+//The cooToA() of the baseline firmware, libm in double. isMapped keeps its map(b, -90, 90, 180, 0),
+//which truncates b to a whole degree, otherwise b is mapped exactly.
+static void cooToA_Double(const float *xyz, float *abc, bool isMapped)
+{
+	double x = xyz[0], y = xyz[1], z = xyz[2];
+	double a = M_PI / 2 - atan2(z, y);
+	double x4 = L1 * sin(a), x5 = L1 * cos(a);
+	double d = sqrt(pow(z - x5, 2) + pow(y - x4, 2) + pow(x, 2));
+	if (d > DR)
+	{
+		double k = DR / d;
+		x = k * x;
+		y = k * (y - x4) + x4;
+		z = k * (z - x5) + x5;
+	}
+	double l23 = sqrt(pow(z - x5, 2) + pow(y - x4, 2) + pow(x, 2));
+	double w = x / l23;
+	double v = (L2 * L2 + l23 * l23 - L3 * L3) / (2 * L2 * l23);
+	double b = (asin(w) - acos(v)) / M_PI * 180;
+	double c = (M_PI - acos((L2 * L2 + L3 * L3 - l23 * l23) / (2 * L3 * L2))) / M_PI * 180;
+	abc[0] = a / M_PI * 180;
+	abc[1] = isMapped ? map(b, -90, 90, 180, 0) : 90 - b;
+	abc[2] = c;
+}
+
+static double maxError(double e, double fast, double exact)
+{
+	return fmax(e, fabs(fast - exact));
+}
+
+//Foot points over the working volume and past DR. Points the double path cannot solve (inside the
+//minimum reach, where its acos() argument leaves [-1, 1]) are left out.
+static int makeFootPoints(float (*pts)[3], int size)
+{
+	int n = 0;
+	for (float x = -80; x <= 80 && n < size; x += 4)
+	{
+		for (float y = 20; y <= 150 && n < size; y += 4)
+		{
+			for (float z = -80; z <= 80 && n < size; z += 4)
+			{
+				float xyz[3] = {x, y, z}, abc[3];
+				cooToA_Double(xyz, abc, false);
+				if (!std::isnan(abc[0] + abc[1] + abc[2]))
+				{
+					pts[n][0] = x;
+					pts[n][1] = y;
+					pts[n][2] = z;
+					n++;
+				}
+			}
+		}
+	}
+	return n;
+}
+
+static void checkCooToA(const float (*pts)[3], int n)
+{
+	double e[3] = {0, 0, 0}, eMapped = 0;
+	int compared = 0;
+	for (int i = 0; i < n; i++)
+	{
+		if (hypot(pts[i][1], pts[i][2]) < L1)
+		{
+			continue; // The double path mirrored feet nearer the body axis than L1 outwards.
+		}
+		compared++;
+		float fast[3], exact[3], mapped[3];
+		cooToA((float *)pts[i], fast);
+		cooToA_Double(pts[i], exact, false);
+		cooToA_Double(pts[i], mapped, true);
+		for (int k = 0; k < 3; k++)
+		{
+			e[k] = maxError(e[k], fast[k], exact[k]);
+		}
+		eMapped = maxError(eMapped, fast[1], mapped[1]);
+	}
+	printf("cooToA over %d points, max error a %.4f, b %.4f, c %.4f deg, b against the truncating map() %.3f deg\n", compared, e[0], e[1], e[2], eMapped);
+	// The bounds in the cooToA_Legs() comment.
+	CHECK(e[0] < 0.01 && e[1] < 0.01 && e[2] < 0.01);
+	CHECK(eMapped < 1.0);
+}
+
+//cooToA() then aToCoo() must land on the point clampFootPoint() gives, the foot lastPt has to hold.
+static void checkRoundTrip(const float *xyz, double &e)
+{
+	float abc[3], fk[3], clamped[3] = {xyz[0], xyz[1], xyz[2]};
+	cooToA((float *)xyz, abc);
+	aToCoo(abc, fk);
+	clampFootPoint(clamped);
+	for (int k = 0; k < 3; k++)
+	{
+		e = std::isnan(fk[k]) ? INFINITY : fmax(e, fabs(fk[k] - clamped[k]));
+	}
+}
+
+static void checkForwardKinematics(const float (*pts)[3], int n)
+{
+	double e = 0;
+	for (int i = 0; i < n; i++)
+	{
+		checkRoundTrip(pts[i], e);
+	}
+	printf("aToCoo(cooToA(p)) against clampFootPoint(p), %d points: max %.4f mm\n", n, e);
+	CHECK(e < 0.01);
+
+	// Inside the minimum reach L3 - L2 the leg is folded completely, the foot stops on DR_MIN.
+	double eMin = 0;
+	for (float r = 0; r <= 6; r += 0.25f)
+	{
+		for (float t = 0; t < 6.28f; t += 0.3f)
+		{
+			float hipPt[3] = {0, (float)(L1 * cos(t * 0.1)), (float)(L1 * sin(t * 0.1))}; // Intersection of L1 and L2.
+			float xyz[3] = {r * cosf(t), hipPt[1] + r * sinf(t) * 0.6f, hipPt[2] + r * sinf(t) * 0.8f};
+			checkRoundTrip(xyz, eMin);
+		}
+	}
+	printf("the same within 6 mm of the intersection of L1 and L2: max %.4f mm\n", eMin);
+	CHECK(eMin < 0.01);
+}
+
+static volatile float sink; //Keeps the timed results alive.
+
+static void timeCooToA(const float (*pts)[3], int n)
+{
+	const int rounds = 20;
+	double t0 = hostNow();
+	for (int r = 0; r < rounds; r++)
+	{
+		for (int i = 0; i + 4 <= n; i += 4)
+		{
+			float ag[4][3];
+			cooToA_All((float(*)[3])pts[i], ag);
+			sink += ag[0][0] + ag[3][2];
+		}
+	}
+	double fastNs = (hostNow() - t0) * 1e9 / (rounds * (n & ~3));
+	t0 = hostNow();
+	for (int r = 0; r < rounds; r++)
+	{
+		for (int i = 0; i < (n & ~3); i++)
+		{
+			float abc[3];
+			cooToA_Double(pts[i], abc, true);
+			sink += abc[0] + abc[2];
+		}
+	}
+	double doubleNs = (hostNow() - t0) * 1e9 / (rounds * (n & ~3));
+	printf("cooToA per leg: float %.1f ns, former double %.1f ns (%.1fx)\n", fastNs, doubleNs, doubleNs / fastNs);
+}
+
+int main()
+{
+	static float pts[60000][3];
+	int n = makeFootPoints(pts, 60000);
+	CHECK(n > 10000);
+	checkCooToA(pts, n);
+	checkForwardKinematics(pts, n);
+	timeCooToA(pts, n);
+	return hostTestResult();
+}
@@ -0,0 +1,150 @@
+/**
+ * @file MessageParserBench.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief MessageParser over a corpus of app commands: the fields it splits, ns/message and allocations/message.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "MessageParser.h"
+#include <new>
+#include <stdlib.h>
+
+// Every operator new of the program is counted, String and std::string allocate through it.
+static unsigned long allocationCount = 0;
+
+void *operator new(size_t size)
+{
+	allocationCount++;
+	void *p = malloc(size ? size : 1);
+	if (p == NULL)
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+// Lines as the app sends them: walk, pose, network and calibration.
+static const char *corpus[] = {
+	"F#0#0#0#0#\n",
+	"F#90#25#0#5#\n",
+	"F#-135#35#-12#8#\n",
+	"F#45#18#20#10#\n",
+	"E#0#0#0#0#0#0#\n",
+	"E#-12#8#15#-10#5#20#\n",
+	"E#20#-20#-30#15#-15#-10#\n",
+	"N#1#Freenove_Dog_5G#12345678#\n",
+	"N#2#MyHomeNetwork#correct horse battery#\n",
+	"J#0#1#-3#4#5#\n",
+	"J#3#2#10#-12#0#\n",
+	"J#1#0#0#0#0#\n",
+};
+#define CORPUS_SIZE (sizeof(corpus) / sizeof(corpus[0]))
+
+// The String parser MessageParser replaced, kept here to compare against.
+struct StringParser
+{
+	String inputCommandArray[COMMANDS_COUNT_MAX];
+	String inputStringTemp;
+	int paramters[COMMANDS_COUNT_MAX], paramterCount = 0;
+	char commandChar;
+
+	void parser(String msg)
+	{
+		commandChar = 0;
+		for (int i = 0; i < COMMANDS_COUNT_MAX; i++)
+		{
+			inputCommandArray[i] = "";
+			paramters[i] = 0;
+		}
+		inputStringTemp = msg;
+		for (u8 i = 0; i < COMMANDS_COUNT_MAX; i++)
+		{
+			int index = inputStringTemp.indexOf(INTERVAL_CHAR);
+			if (index < 0)
+			{
+				break;
+			}
+			paramterCount = i;
+			inputCommandArray[i] = inputStringTemp.substring(0, index);
+			inputStringTemp = inputStringTemp.substring(index + 1);
+			paramters[i] = inputCommandArray[i].toInt();
+		}
+		commandChar = inputCommandArray[0].charAt(0);
+	}
+};
+
+static void checkFields()
+{
+	MessageParser mp;
+	StringParser sp;
+	for (u8 i = 0; i < CORPUS_SIZE; i++)
+	{
+		mp.parser(corpus[i], strlen(corpus[i]));
+		sp.parser(corpus[i]);
+		CHECK(mp.commandChar == corpus[i][0]);
+		CHECK(mp.commandChar == sp.commandChar);
+		CHECK(mp.paramterCount == sp.paramterCount);
+		for (int k = 0; k <= mp.paramterCount; k++)
+		{
+			CHECK(mp.paramters[k] == sp.paramters[k]);
+			CHECK(strcmp(mp.fields[k].data, sp.inputCommandArray[k].c_str()) == 0);
+			CHECK(mp.fields[k].length == strlen(mp.fields[k].data));
+		}
+	}
+
+	mp.parser("N#1#my ssid#", 12);
+	CHECK(mp.paramterCount == 2 && strcmp(mp.fields[2].data, "my ssid") == 0);
+	mp.parser("F#10#20", 7); // The last field has no '#'.
+	CHECK(mp.paramterCount == 1 && mp.paramters[1] == 10);
+	mp.parser("", 0);
+	CHECK(mp.commandChar == 0 && mp.paramterCount == 0);
+}
+
+template <typename Parse>
+static void timeParser(const char *name, Parse parse)
+{
+	const int rounds = 200000;
+	unsigned long allocations = allocationCount;
+	double t = hostNow();
+	for (int r = 0; r < rounds; r++)
+	{
+		for (u8 i = 0; i < CORPUS_SIZE; i++)
+		{
+			parse(corpus[i]);
+		}
+	}
+	t = hostNow() - t;
+	double messages = (double)rounds * CORPUS_SIZE;
+	printf("%-14s %7.1f ns/message %6.2f allocations/message\n", name, t * 1e9 / messages,
+		   (allocationCount - allocations) / messages);
+}
+
+int main()
+{
+	checkFields();
+
+	MessageParser mp;
+	StringParser sp;
+	volatile int sink = 0;
+	unsigned long allocations = allocationCount;
+	timeParser("MessageParser", [&](const char *msg) { mp.parser(msg, strlen(msg)); sink += mp.paramters[1]; });
+	CHECK(allocationCount == allocations);
+	// std::string keeps short strings inline, the Arduino String allocates for each of them.
+	timeParser("String parser", [&](const char *msg) { sp.parser(msg); sink += sp.paramters[1]; });
+	return hostTestResult();
+}
@@ -0,0 +1,43 @@
+/**
+ * @file MotionStubs.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief No-op ends of the firmware that Motion.cpp links against, for the kinematics host tests.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "Public.h"
+
+PreferencesPro prefs;
+
+PreferencesPro::PreferencesPro() {}
+PreferencesPro::~PreferencesPro() {}
+size_t Preferences::putBytes(const char *, const void *, size_t) { return 0; }
+size_t Preferences::getBytes(const char *, void *, size_t) { return 0; }
+size_t Preferences::getBytesLength(const char *) { return 0; }
+
+Freenove_PCA9685::Freenove_PCA9685(u8 i2c_addr) { address = i2c_addr; }
+
+void stepCacheInvalidate() {}
+
+void motionClockStart() {}
+int motionTick(int t, int) { return t + 1; }
+bool gaitTick() { return false; }
+u8 gaitQueueLength() { return 0; }
+bool gaitQueueTarget(int, float, int, int, int) { return false; }
+
+void servoOutputBeginFrame() {}
+void servoOutputCommitFrame() {}
+void servoOutputLoadOffsets() {}
+void servoOutputSetLegs(const float (*)[3], bool) {}
+void servoOutputSetAngle(u8, float) {}
+void servoOutputSetJoint(u8, u8, float, bool) {}
+void servoOutputSetLegAngles(const int16_t *) {}
+const float *servoOutputTargetAngles()
+{
+	static float angle[LEG_JOINTS];
+	return angle;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file PCA9685Test.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Freenove_PCA9685 against a mock TwoWire: frame coalescing, the dirty mask and the shadow cache.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "Freenove_PCA9685.h"
+#include <vector>
+
+//A PCA9685 on the bus: 256 registers, auto-increment while MODE1_AI is set.
+struct MockTransaction
+{
+	u8 reg;
+	u8 size; //Data bytes after the register pointer.
+};
+
+static u8 mockRegs[256];
+static u8 mockPointer;
+static std::vector<u8> mockTx;
+static std::vector<MockTransaction> mockLog;
+static int mockNackWrites; //The next writes answered with a data NACK.
+static u8 mockRxPos, mockRxLength;
+static size_t mockReadLimit = 256; //Bytes the chip answers a read with before it stops.
+
+TwoWire Wire;
+
+bool TwoWire::begin(int, int, uint32_t) { return true; }
+bool TwoWire::setClock(uint32_t) { return true; }
+void TwoWire::beginTransmission(int) { mockTx.clear(); }
+void TwoWire::beginTransmission(uint8_t) { mockTx.clear(); }
+void TwoWire::beginTransmission(uint16_t) { mockTx.clear(); }
+
+size_t TwoWire::write(uint8_t data)
+{
+	mockTx.push_back(data);
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t size)
+{
+	mockTx.insert(mockTx.end(), data, data + size);
+	return size;
+}
+
+uint8_t TwoWire::endTransmission(bool)
+{
+	if (mockTx.size() > 1 && mockNackWrites > 0)
+	{
+		mockNackWrites--;
+		return 3;
+	}
+	mockPointer = mockTx[0];
+	for (size_t i = 1; i < mockTx.size(); i++)
+	{
+		mockRegs[mockPointer] = mockTx[i];
+		if (mockRegs[MODE1] & MODE1_AI)
+		{
+			mockPointer++;
+		}
+	}
+	if (mockTx.size() > 1)
+	{
+		mockLog.push_back({mockTx[0], (u8)(mockTx.size() - 1)});
+	}
+	return 0;
+}
+
+uint8_t TwoWire::endTransmission()
+{
+	return endTransmission(true);
+}
+
+size_t TwoWire::requestFrom(uint16_t, size_t count, bool)
+{
+	mockRxPos = 0;
+	mockRxLength = count < mockReadLimit ? count : mockReadLimit;
+	return mockRxLength;
+}
+
+int TwoWire::available()
+{
+	return mockRxLength - mockRxPos;
+}
+
+int TwoWire::read()
+{
+	mockRxPos++;
+	return mockRegs[mockPointer++];
+}
+
+static void checkChannel(int chn, int on, int off)
+{
+	const u8 *r = &mockRegs[LED0_ON_L + 4 * chn];
+	CHECK((r[0] | r[1] << 8) == on);
+	CHECK((r[2] | r[3] << 8) == off);
+}
+
+int main()
+{
+	Freenove_PCA9685 pca;
+	CHECK(pca.begin() == 0);
+	CHECK(pca.getBusClock() == PCA9685_I2C_CLOCK_FM);
+	CHECK(mockRegs[MODE1] & MODE1_AI);
+
+	// First frame: every channel is unknown, twelve servos go out in one burst.
+	mockLog.clear();
+	pca.clearStats();
+	pca.beginFrame();
+	for (int i = 0; i < 12; i++)
+	{
+		pca.setPWM(i, 0, 300 + i);
+	}
+	CHECK(mockLog.empty()); // Staged only.
+	CHECK(pca.commitFrame() == 0);
+	CHECK(mockLog.size() == 1);
+	CHECK(mockLog[0].reg == LED0_ON_L && mockLog[0].size == 48);
+	for (int i = 0; i < 12; i++)
+	{
+		checkChannel(i, 0, 300 + i);
+	}
+	CHECK(pca.getStats().channelsWritten == 12);
+
+	// The same frame again is already on the chip.
+	mockLog.clear();
+	pca.beginFrame();
+	for (int i = 0; i < 12; i++)
+	{
+		pca.setPWM(i, 0, 300 + i);
+	}
+	CHECK(pca.commitFrame() == 0);
+	CHECK(mockLog.empty());
+	CHECK(pca.getStats().channelsSkipped == 12);
+
+	// Channels 2, 3 and 7 change: one transaction per contiguous run.
+	pca.beginFrame();
+	for (int i = 0; i < 12; i++)
+	{
+		pca.setPWM(i, 0, i == 2 || i == 3 || i == 7 ? 400 + i : 300 + i);
+	}
+	CHECK(pca.commitFrame() == 0);
+	CHECK(mockLog.size() == 2);
+	CHECK(mockLog[0].reg == LED0_ON_L + 8 && mockLog[0].size == 8);
+	CHECK(mockLog[1].reg == LED0_ON_L + 28 && mockLog[1].size == 4);
+	checkChannel(3, 0, 403);
+	checkChannel(7, 0, 407);
+
+	// A channel set back to its chip value inside the frame is no longer dirty.
+	mockLog.clear();
+	pca.beginFrame();
+	pca.setPWM(5, 0, 999);
+	pca.setPWM(5, 0, 305);
+	CHECK(pca.commitFrame() == 0);
+	CHECK(mockLog.empty());
+
+	// A NACKed run stays dirty and is sent again by the next frame.
+	mockNackWrites = 1;
+	pca.beginFrame();
+	pca.setPWM(9, 0, 509);
+	CHECK(pca.commitFrame() == 3);
+	CHECK(mockLog.empty());
+	CHECK(pca.getStats().nackCount == 1);
+	pca.beginFrame();
+	CHECK(pca.commitFrame() == 0);
+	CHECK(mockLog.size() == 1 && mockLog[0].reg == LED0_ON_L + 36 && mockLog[0].size == 4);
+	checkChannel(9, 0, 509);
+
+	// Nested frames flush once, at the outermost commit.
+	mockLog.clear();
+	pca.beginFrame();
+	pca.setPWM(0, 0, 100);
+	pca.beginFrame();
+	pca.setPWM(1, 0, 101);
+	CHECK(pca.commitFrame() == 0);
+	CHECK(mockLog.empty());
+	CHECK(pca.commitFrame() == 0);
+	CHECK(mockLog.size() == 1 && mockLog[0].reg == LED0_ON_L && mockLog[0].size == 8);
+
+	// A lone setPWM() is its own frame.
+	mockLog.clear();
+	pca.setPWM(15, 0, 215);
+	CHECK(mockLog.size() == 1 && mockLog[0].reg == LED0_ON_L + 60 && mockLog[0].size == 4);
+
+	// A read the chip does not answer is an error and is counted.
+	pca.clearStats();
+	mockReadLimit = 0;
+	CHECK(!pca.selfTest());
+	CHECK(pca.getStats().readFailCount == 1);
+	mockReadLimit = 256;
+	CHECK(pca.selfTest());
+	CHECK(pca.getStats().readFailCount == 1 && pca.getStats().shortReadCount == 0);
+
+	return hostTestResult();
+}
@@ -0,0 +1,214 @@
+/**
+ * @file RingBench.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Push and pop cost of MpmcRing, SpscRing and MessageQueue against the DataQueue they replaced.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "MassageQueue.h"
+#include "SpscRing.h"
+
+// DataQueue as it was in MassageQueue.h, without getValue() and with delete[] in the destructor.
+// It took no lock, so it is timed on one thread like the rings.
+template <typename T>
+class DataQueue
+{
+private:
+	uint16_t queue_size;
+	T *values;
+	uint16_t head;
+	uint16_t tail;
+	T maxVal;
+	T minVal;
+	bool enableMaxMin;
+
+	void calculateMaxMin()
+	{
+		if (enableMaxMin)
+		{
+			T val;
+			maxVal = T('\0');
+			minVal = T(0xFFFFFFFF);
+			for (int i = 0; i < length(); i++)
+			{
+				val = values[(head + i) % queue_size];
+				maxVal = val > maxVal ? val : maxVal;
+				minVal = val < minVal ? val : minVal;
+			}
+		}
+	}
+
+public:
+	DataQueue(int queueSize = 3, bool _enableMaxMin = false)
+	{
+		enableMaxMin = _enableMaxMin;
+		queue_size = queueSize;
+		values = new T[queue_size];
+		head = 0;
+		tail = 0;
+	}
+
+	~DataQueue()
+	{
+		delete[] values;
+	}
+
+	bool enter(T val)
+	{
+		if (!isFull())
+		{
+			values[tail] = val;
+			tail = (tail + 1) % queue_size;
+			calculateMaxMin();
+			return true;
+		}
+		return false;
+	}
+
+	//Force to enqueue. When the queue is full, the dequeue will be executed first, and then normally enqueue.
+	bool enterForced(T val)
+	{
+		if (!enter(val))
+		{
+			out();
+			return enter(val);
+		}
+		return true;
+	}
+
+	T out()
+	{
+		T res = T(0);
+		if (!isEmpty())
+		{
+			res = values[head];
+			values[head] = T('\0');
+			head = (head + 1) % queue_size;
+			calculateMaxMin();
+		}
+		return res;
+	}
+
+	bool isEmpty()
+	{
+		return head == tail;
+	}
+
+	bool isFull()
+	{
+		return (tail + 1) % queue_size == head;
+	}
+
+	uint16_t length()
+	{
+		int len = tail - head;
+		return len >= 0 ? len : len + queue_size;
+	}
+};
+
+#define ROUNDS 1000000
+#define MQ_TX_LENGTH 32 // As Public.h.
+#define MQ_BZ_LENGTH 16
+
+static volatile long sink;
+
+static void report(const char *name, double t)
+{
+	printf("%-28s %6.1f ns/message\n", name, t * 1e9 / ROUNDS);
+}
+
+//Keep a few values queued, then push one and pop one per round.
+static void timeValues()
+{
+	DataQueue<int> dq(MQ_BZ_LENGTH + 1);
+	MpmcRing<int, MQ_BZ_LENGTH> mpmc;
+	SpscRing<int, MQ_BZ_LENGTH> spsc;
+	long sum = 0;
+	int v = 0, misses = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		dq.enter(i);
+		mpmc.push(i);
+		spsc.push(i);
+	}
+
+	double t = hostNow();
+	for (int i = 0; i < ROUNDS; i++)
+	{
+		dq.enter(i);
+		sum += dq.out();
+	}
+	report("DataQueue<int>", hostNow() - t);
+
+	t = hostNow();
+	for (int i = 0; i < ROUNDS; i++)
+	{
+		if (mpmc.push(i) && mpmc.pop(v))
+		{
+			sum += v;
+		}
+		else
+		{
+			misses++;
+		}
+	}
+	report("MpmcRing<int>", hostNow() - t);
+
+	t = hostNow();
+	for (int i = 0; i < ROUNDS; i++)
+	{
+		if (spsc.push(i) && spsc.pop(v))
+		{
+			sum += v;
+		}
+		else
+		{
+			misses++;
+		}
+	}
+	report("SpscRing<int>", hostNow() - t);
+	CHECK(misses == 0);
+	sink = sum;
+}
+
+//A telemetry line from text to the taker, as BatteryPower and UltrasonicRanging send it.
+static void timeMessages()
+{
+	DataQueue<String> dq(MQ_TX_LENGTH + 1);
+	MessageQueue<MQ_TX_LENGTH> mq;
+	long sum = 0;
+
+	double t = hostNow();
+	for (int i = 0; i < ROUNDS; i++)
+	{
+		dq.enterForced(String("H#") + String(i % 400) + "#\n");
+		sum += dq.out().length();
+	}
+	report("DataQueue<String> forced", hostNow() - t);
+
+	t = hostNow();
+	for (int i = 0; i < ROUNDS; i++)
+	{
+		MessageHandle h;
+		mq.printfForced("H#%d#\n", i % 400);
+		if (mq.out(h))
+		{
+			sum += strlen(messageText(h));
+			messageFree(h);
+		}
+	}
+	report("MessageQueue printfForced", hostNow() - t);
+	sink = sum;
+}
+
+int main()
+{
+	timeValues();
+	timeMessages();
+	return hostTestResult();
+}
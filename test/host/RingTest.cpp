@@ -0,0 +1,218 @@
+/**
+ * @file RingTest.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief MpmcRing, SpscRing and MessageQueue under threads, built with ThreadSanitizer: nothing lost, nothing twice.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "MassageQueue.h"
+#include "SpscRing.h"
+#include <thread>
+#include <vector>
+
+#define PRODUCERS	4
+#define CONSUMERS	3
+#define MESSAGES	20000	//Per producer. The host may have one core, every wait yields.
+
+//Each producer pushes its id and a count, each value must be popped exactly once.
+static void checkMpmc()
+{
+	static MpmcRing<uint32_t, 16> ring;
+	static std::atomic<uint8_t> seen[PRODUCERS * MESSAGES];
+	std::atomic<uint32_t> popped(0);
+	std::vector<std::thread> threads;
+	for (uint32_t p = 0; p < PRODUCERS; p++)
+	{
+		threads.emplace_back([p] {
+			for (uint32_t i = 0; i < MESSAGES; i++)
+			{
+				while (!ring.push(p * MESSAGES + i))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+	for (int c = 0; c < CONSUMERS; c++)
+	{
+		threads.emplace_back([&popped] {
+			uint32_t v;
+			while (popped.load() < PRODUCERS * MESSAGES)
+			{
+				if (ring.pop(v))
+				{
+					if (v < PRODUCERS * MESSAGES)
+					{
+						seen[v].fetch_add(1);
+					}
+					popped.fetch_add(1);
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		threads[i].join();
+	}
+	uint32_t v, missing = 0, twice = 0;
+	for (uint32_t i = 0; i < PRODUCERS * MESSAGES; i++)
+	{
+		missing += seen[i].load() == 0;
+		twice += seen[i].load() > 1;
+	}
+	CHECK(popped.load() == PRODUCERS * MESSAGES);
+	CHECK(missing == 0);
+	CHECK(twice == 0);
+	CHECK(ring.isEmpty() && !ring.pop(v));
+}
+
+//One producer and one consumer, the values come out in order.
+static void checkSpsc()
+{
+	static SpscRing<uint32_t, 16> ring;
+	uint32_t outOfOrder = 0;
+	std::thread producer([] {
+		for (uint32_t i = 0; i < PRODUCERS * MESSAGES; i++)
+		{
+			while (!ring.push(i))
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+	std::thread consumer([&outOfOrder] {
+		uint32_t v;
+		for (uint32_t i = 0; i < PRODUCERS * MESSAGES;)
+		{
+			if (ring.pop(v))
+			{
+				outOfOrder += v != i;
+				i++;
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+	producer.join();
+	consumer.join();
+	CHECK(outOfOrder == 0);
+	CHECK(ring.isEmpty());
+}
+
+static bool outText(MessageQueue<4> &mq, const char *text)
+{
+	MessageHandle h;
+	if (!mq.out(h))
+	{
+		return false;
+	}
+	bool isSame = strcmp(messageText(h), text) == 0;
+	messageFree(h);
+	return isSame;
+}
+
+//enter() drops the new message on a full queue, enterForced() and printfForced() the oldest.
+static void checkForced()
+{
+	static MessageQueue<4> mq;
+	MessagePoolStats st;
+	for (int i = 0; i < 4; i++)
+	{
+		CHECK(mq.printf("%d", i));
+	}
+	CHECK(!mq.enter("4"));
+	CHECK(mq.printfForced("%d", 5));
+	CHECK(mq.getDropped() == 2);
+	CHECK(outText(mq, "1") && outText(mq, "2") && outText(mq, "3") && outText(mq, "5"));
+
+	for (int i = 0; i < 4; i++)
+	{
+		CHECK(mq.printf("%d", i));
+	}
+	MessageHandle spare[MESSAGE_POOL_BLOCKS];
+	int spares = 0;
+	while (messageAlloc(spare[spares]))
+	{
+		spares++;
+	}
+	CHECK(spares == MESSAGE_POOL_BLOCKS - 4);
+	CHECK(mq.printfForced("%s", "latest")); // Takes the block of "0".
+	CHECK(outText(mq, "1") && outText(mq, "2") && outText(mq, "3") && outText(mq, "latest"));
+	for (int i = 0; i < spares; i++)
+	{
+		messageFree(spare[i]);
+	}
+	getMessagePoolStats(st);
+	CHECK(st.inUse == 0);
+}
+
+//Producers force telemetry into a short queue while consumers take it: every block comes back to the pool.
+static void checkForcedThreads()
+{
+	static MessageQueue<4> mq;
+	std::atomic<int> producersDone(0);
+	std::vector<std::thread> threads;
+	for (int p = 0; p < PRODUCERS; p++)
+	{
+		threads.emplace_back([p, &producersDone] {
+			for (int i = 0; i < MESSAGES / 4; i++)
+			{
+				mq.printfForced("%d#%d#", p, i);
+				if (i % 8 == 0)
+				{
+					std::this_thread::yield();
+				}
+			}
+			producersDone.fetch_add(1);
+		});
+	}
+	for (int c = 0; c < CONSUMERS - 1; c++)
+	{
+		threads.emplace_back([&producersDone] {
+			MessageHandle h;
+			while (producersDone.load() < PRODUCERS || !mq.isEmpty())
+			{
+				if (mq.out(h))
+				{
+					messageFree(h);
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		threads[i].join();
+	}
+	MessageHandle h;
+	while (mq.out(h))
+	{
+		messageFree(h);
+	}
+	MessagePoolStats st;
+	getMessagePoolStats(st);
+	CHECK(st.inUse == 0);
+}
+
+int main()
+{
+	checkMpmc();
+	checkSpsc();
+	checkForced();
+	checkForcedThreads();
+	return hostTestResult();
+}
@@ -0,0 +1,94 @@
+/**
+ * @file WindowStatsTest.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief WindowStats against a rescan of the whole window after every sample.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include "HostTest.h"
+#include "WindowStats.h"
+#include <deque>
+#include <math.h>
+#include <random>
+
+#define SAMPLES 50000
+
+static std::mt19937 rng(2026);
+
+static bool isNear(double a, double b)
+{
+	return fabs(a - b) <= 1e-5 * (1 + fabs(b));
+}
+
+//Random samples in [low, high], with runs of equal values so ties are pushed too. Clear once on the way.
+template <typename T, uint16_t N>
+static void checkWindow(const char *name, double low, double high)
+{
+	WindowStats<T, N> ws;
+	std::deque<T> window;
+	std::uniform_real_distribution<double> value(low, high);
+	int failures = 0;
+	T last = 0;
+	for (int i = 0; i < SAMPLES; i++)
+	{
+		if (i == SAMPLES / 2)
+		{
+			ws.clear();
+			window.clear();
+			failures += ws.length() != 0 || ws.getMax() != 0 || ws.getMean() != 0 || ws.getVariance() != 0;
+		}
+		T x = rng() % 4 == 0 ? last : (T)value(rng);
+		last = x;
+		ws.push(x);
+		window.push_back(x);
+		if (window.size() > N)
+		{
+			window.pop_front();
+		}
+
+		T max = window[0], min = window[0];
+		double sum = 0;
+		for (size_t k = 0; k < window.size(); k++)
+		{
+			max = window[k] > max ? window[k] : max;
+			min = window[k] < min ? window[k] : min;
+			sum += window[k];
+		}
+		double mean = sum / window.size(), variance = 0;
+		for (size_t k = 0; k < window.size(); k++)
+		{
+			variance += (window[k] - mean) * (window[k] - mean);
+		}
+		variance /= window.size();
+
+		// The mean and variance come back as float.
+		if (ws.length() != window.size() || ws.getMax() != max || ws.getMin() != min || !isNear(ws.getMean(), (float)mean) ||
+			fabs(ws.getVariance() - variance) > 1e-5 * (1 + variance) + 1e-6 * mean * mean)
+		{
+			if (failures++ == 0)
+			{
+				printf("%s window %u, sample %d: max %g/%g min %g/%g mean %g/%g variance %g/%g\n", name, (unsigned)N, i, (double)ws.getMax(),
+					   (double)max, (double)ws.getMin(), (double)min, ws.getMean(), mean, ws.getVariance(), variance);
+			}
+		}
+	}
+	CHECK(failures == 0);
+}
+
+int main()
+{
+	checkWindow<uint16_t, 10>("uint16", 3000, 8000);
+	checkWindow<uint16_t, 257>("uint16", 0, 65535);
+	checkWindow<int, 7>("int", -100, 100);
+	checkWindow<int, 100>("int", -2000000, 2000000);
+	checkWindow<float, 16>("float", -5, 5);
+	checkWindow<float, 3>("float", 1000, 1001);
+	checkWindow<int8_t, 1>("int8", -128, 127);
+	checkWindow<int8_t, 33>("int8", -128, 127);
+	checkWindow<unsigned long, 100>("u32", 0, 20000); // The motion jitter window, u32 is unsigned long.
+	return hostTestResult();
+}
@@ -0,0 +1,125 @@
+#pragma once
+//Host stand-in for the Arduino-ESP32 core: declarations only, ArduinoShim.cpp defines what the host tests call.
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+#ifndef ARDUINO
+#define ARDUINO 10816
+#endif
+#define PI 3.1415926535897932384626433832795
+#define HEX 16
+#define DEC 10
+#define LOW 0
+#define HIGH 1
+#define INPUT 1
+#define OUTPUT 3
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define ESP_LOGI(...)
+#define ESP_LOGE(...)
+#define ESP_LOGW(...)
+#define log_e(...)
+#define log_i(...)
+#define log_w(...)
+#define ESP_ERROR_CHECK(x) (x)
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+typedef uint8_t byte;
+typedef bool boolean;
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+long map(long, long, long, long, long);
+void delay(uint32_t);
+void delayMicroseconds(uint32_t);
+unsigned long millis();
+unsigned long micros();
+void pinMode(uint8_t, uint8_t);
+void digitalWrite(uint8_t, uint8_t);
+int digitalRead(uint8_t);
+unsigned long pulseIn(uint8_t, uint8_t, unsigned long);
+void *ps_malloc(size_t);
+void *ps_calloc(size_t, size_t);
+int64_t esp_timer_get_time();
+class String {
+public:
+	std::string s;
+	String() {}
+	String(const char *c) : s(c ? c : "") {}
+	String(const std::string &c) : s(c) {}
+	String(char c) : s(1, c) {}
+	String(int v, int base = 10) { char b[34]; if (base == 16) snprintf(b, 34, "%x", v); else snprintf(b, 34, "%d", v); s = b; }
+	String(unsigned int v, int base = 10) { char b[34]; snprintf(b, 34, base == 16 ? "%x" : "%u", v); s = b; }
+	String(long v, int base = 10) { char b[34]; snprintf(b, 34, base == 16 ? "%lx" : "%ld", v); s = b; }
+	String(unsigned long v, int base = 10) { char b[34]; snprintf(b, 34, base == 16 ? "%lx" : "%lu", v); s = b; }
+	String(uint32_t v, unsigned char base);
+	String(float v, unsigned int d = 2) { char b[34]; snprintf(b, 34, "%.*f", d, v); s = b; }
+	String(double v, unsigned int d = 2) { char b[34]; snprintf(b, 34, "%.*f", d, v); s = b; }
+	const char *c_str() const { return s.c_str(); }
+	unsigned int length() const { return s.size(); }
+	char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+	int indexOf(char c) const { size_t p = s.find(c); return p == std::string::npos ? -1 : (int)p; }
+	String substring(unsigned int a) const { return a < s.size() ? String(s.substr(a)) : String(); }
+	String substring(unsigned int a, unsigned int b) const { return String(s.substr(a, b - a)); }
+	long toInt() const { return atol(s.c_str()); }
+	bool equals(const String &o) const { return s == o.s; }
+	bool equals(const char *o) const { return s == o; }
+	void toUpperCase() {}
+	String &operator+=(const String &o) { s += o.s; return *this; }
+	String &operator+=(const char *o) { s += o; return *this; }
+	String &operator+=(char o) { s += o; return *this; }
+	char operator[](unsigned int i) const { return s[i]; }
+	bool operator==(const String &o) const { return s == o.s; }
+	bool operator<(const String &o) const { return s < o.s; }
+	bool operator>(const String &o) const { return s > o.s; }
+};
+inline String operator+(const String &a, const String &b) { return String(a.s + b.s); }
+inline String operator+(const String &a, const char *b) { return String(a.s + b); }
+inline String operator+(const char *a, const String &b) { return String(a + b.s); }
+inline String operator+(const String &a, char b) { return String(a.s + b); }
+inline String operator+(const String &a, int b) { return a + String(b); }
+inline String operator+(const String &a, unsigned int b) { return a + String(b); }
+inline String operator+(const String &a, long b) { return a + String(b); }
+inline String operator+(const String &a, unsigned long b) { return a + String(b); }
+inline String operator+(const String &a, uint8_t b) { return a + String((int)b); }
+inline String operator+(const String &a, float b) { return a + String(b); }
+class Print {
+public:
+	size_t print(const char *);
+	size_t print(const String &);
+	size_t print(char);
+	size_t print(int, int = DEC);
+	size_t print(unsigned int, int = DEC);
+	size_t print(long, int = DEC);
+	size_t print(unsigned long, int = DEC);
+	size_t print(double, int = 2);
+	size_t println(const char *);
+	size_t println(const String &);
+	size_t println(char);
+	size_t println(int, int = DEC);
+	size_t println(unsigned int, int = DEC);
+	size_t println(long, int = DEC);
+	size_t println(unsigned long, int = DEC);
+	size_t println(double, int = 2);
+	size_t println();
+	size_t printf(const char *, ...) __attribute__((format(printf, 2, 3)));
+	size_t write(const uint8_t *, size_t);
+	size_t write(const char *);
+};
+class HardwareSerial : public Print {
+public:
+	void begin(unsigned long);
+	int available();
+	int read();
+};
+extern HardwareSerial Serial;
+class EspClass { public: uint64_t getEfuseMac(); uint32_t getFreeHeap(); uint32_t getHeapSize(); };
+extern EspClass ESP;
+#include "freertos/FreeRTOS.h"
+#include "esp_heap_caps.h"
+#include "esp32-hal-timer.h"
@@ -0,0 +1,215 @@
+/**
+ * @file ArduinoShim.cpp
+ * @author suhayl@freenove (support@freenove.com)
+ * @brief Host definitions of the Arduino and FreeRTOS calls the firmware units under test make.
+ * @version v1.0.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2022. Freenove corporation.
+ *
+ */
+
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+HardwareSerial Serial;
+
+static std::chrono::steady_clock::time_point shimStart = std::chrono::steady_clock::now();
+
+unsigned long micros()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - shimStart).count();
+}
+
+int64_t esp_timer_get_time()
+{
+	return micros();
+}
+
+unsigned long millis()
+{
+	return micros() / 1000;
+}
+
+void delay(uint32_t ms)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+	std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+	return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int n = vprintf(format, args);
+	va_end(args);
+	return n > 0 ? n : 0;
+}
+
+size_t Print::print(const char *s)
+{
+	return fputs(s, stdout) < 0 ? 0 : strlen(s);
+}
+
+size_t Print::println(const char *s)
+{
+	return print(s) + print("\n");
+}
+
+TickType_t xTaskGetTickCount()
+{
+	return millis();
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+	delay(ticks);
+}
+
+// One task on the host: the locks only have to nest.
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+	static int handle;
+	return &handle;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex()
+{
+	static int handle;
+	return &handle;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t)
+{
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t)
+{
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t, TickType_t)
+{
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t)
+{
+	return pdTRUE;
+}
+
+void portENTER_CRITICAL(portMUX_TYPE *)
+{
+}
+
+void portEXIT_CRITICAL(portMUX_TYPE *)
+{
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t)
+{
+	return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t)
+{
+	return 0;
+}
+
+void *heap_caps_malloc(size_t size, unsigned int)
+{
+	return malloc(size);
+}
+
+void *heap_caps_calloc(size_t n, size_t size, unsigned int)
+{
+	return calloc(n, size);
+}
+
+fs::SPIFFSFS SPIFFS;
+
+size_t fs::File::write(const uint8_t *buf, size_t size)
+{
+	return handle == NULL ? 0 : fwrite(buf, 1, size, handle);
+}
+
+size_t fs::File::read(uint8_t *buf, size_t size)
+{
+	return handle == NULL ? 0 : fread(buf, 1, size, handle);
+}
+
+bool fs::File::seek(uint32_t pos)
+{
+	return handle != NULL && fseek(handle, pos, SEEK_SET) == 0;
+}
+
+size_t fs::File::size()
+{
+	if (handle == NULL)
+	{
+		return 0;
+	}
+	long pos = ftell(handle);
+	fseek(handle, 0, SEEK_END);
+	long end = ftell(handle);
+	fseek(handle, pos, SEEK_SET);
+	return end;
+}
+
+void fs::File::close()
+{
+	if (handle != NULL)
+	{
+		fclose(handle);
+		handle = NULL;
+	}
+}
+
+fs::File::operator bool() const
+{
+	return handle != NULL;
+}
+
+// SPIFFS paths start with '/', they are kept under hostDir.
+static std::string spiffsHostPath(const char *hostDir, const char *path)
+{
+	return std::string(hostDir) + path;
+}
+
+bool fs::SPIFFSFS::begin(bool, const char *, uint8_t, const char *)
+{
+	return true;
+}
+
+fs::File fs::SPIFFSFS::open(const char *path, const char *mode)
+{
+	return File(fopen(spiffsHostPath(hostDir, path).c_str(), strcmp(mode, FILE_WRITE) == 0 ? "w+b" : "rb"));
+}
+
+bool fs::SPIFFSFS::exists(const char *path)
+{
+	FILE *f = fopen(spiffsHostPath(hostDir, path).c_str(), "rb");
+	if (f != NULL)
+	{
+		fclose(f);
+	}
+	return f != NULL;
+}
+
+bool fs::SPIFFSFS::remove(const char *path)
+{
+	return ::remove(spiffsHostPath(hostDir, path).c_str()) == 0;
+}
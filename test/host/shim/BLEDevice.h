@@ -0,0 +1,3 @@
+#pragma once
+#include <string>
+class BLECharacteristic { public: std::string getValue(); void setValue(std::string); void setValue(uint8_t *, size_t); void notify(); };
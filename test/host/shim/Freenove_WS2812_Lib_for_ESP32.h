@@ -0,0 +1,3 @@
+#pragma once
+#define TYPE_GRB 1
+class Freenove_ESP32_WS2812 { public: Freenove_ESP32_WS2812(int, int, int, int); };
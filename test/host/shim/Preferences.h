@@ -0,0 +1,14 @@
+#pragma once
+#include "Arduino.h"
+class Preferences {
+public:
+	bool begin(const char *, bool = false, const char * = 0);
+	size_t putBytes(const char *, const void *, size_t);
+	size_t getBytes(const char *, void *, size_t);
+	size_t getBytesLength(const char *);
+	size_t putUInt(const char *, uint32_t);
+	uint32_t getUInt(const char *, uint32_t = 0);
+	size_t putUChar(const char *, uint8_t);
+	uint8_t getUChar(const char *, uint8_t = 0);
+	bool isKey(const char *);
+};
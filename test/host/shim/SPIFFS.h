@@ -0,0 +1,30 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+namespace fs {
+class File {
+public:
+	File(FILE *f = NULL) : handle(f) {}
+	size_t write(const uint8_t *, size_t);
+	size_t read(uint8_t *, size_t);
+	bool seek(uint32_t);
+	size_t size();
+	void close();
+	operator bool() const;
+private:
+	FILE *handle;
+};
+class SPIFFSFS {
+public:
+	bool begin(bool formatOnFail = false, const char *basePath = "/spiffs", uint8_t maxOpenFiles = 10, const char *partitionLabel = NULL);
+	File open(const char *path, const char *mode = FILE_READ);
+	bool exists(const char *path);
+	bool remove(const char *path);
+	const char *hostDir = "."; // Host only: the directory the partition is kept in.
+};
+}
+using fs::File;
+extern fs::SPIFFSFS SPIFFS;
@@ -0,0 +1,4 @@
+#pragma once
+#include "Arduino.h"
+class WiFiClient { public: int available(); int read(uint8_t *, size_t); size_t write(const char *); size_t write(const uint8_t *, size_t); };
+class WiFiServer { public: WiFiServer(int); };
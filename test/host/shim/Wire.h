@@ -0,0 +1,22 @@
+#pragma once
+#include "Arduino.h"
+#define I2C_BUFFER_LENGTH 128
+class TwoWire {
+public:
+	bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+	bool setClock(uint32_t);
+	uint32_t getClock();
+	void setTimeOut(uint16_t);
+	uint16_t getTimeOut();
+	void beginTransmission(uint16_t);
+	void beginTransmission(uint8_t);
+	void beginTransmission(int);
+	uint8_t endTransmission(bool);
+	uint8_t endTransmission(void);
+	size_t requestFrom(uint16_t, size_t, bool = true);
+	size_t write(uint8_t);
+	size_t write(const uint8_t *, size_t);
+	int available();
+	int read();
+};
+extern TwoWire Wire;
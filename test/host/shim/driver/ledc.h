@@ -0,0 +1,3 @@
+#pragma once
+typedef int ledc_mode_t; typedef int ledc_timer_t; typedef int ledc_channel_t;
+#define LEDC_TIMER_10_BIT 10
@@ -0,0 +1,2 @@
+#pragma once
+#define TOUCH_PAD_NUM3 3
@@ -0,0 +1,9 @@
+#pragma once
+#include <stdint.h>
+typedef struct hw_timer_s hw_timer_t;
+hw_timer_t *timerBegin(uint8_t, uint16_t, bool);
+void timerEnd(hw_timer_t *);
+void timerAttachInterrupt(hw_timer_t *, void (*)(void), bool);
+void timerAlarmWrite(hw_timer_t *, uint64_t, bool);
+void timerAlarmEnable(hw_timer_t *);
+void timerAlarmDisable(hw_timer_t *);
@@ -0,0 +1,15 @@
+#pragma once
+#include "Arduino.h"
+typedef enum { ADC_CHANNEL_4 = 4 } adc_channel_t;
+typedef enum { ADC_UNIT_1 = 1, ADC_UNIT_2 } adc_unit_t;
+typedef enum { ADC_ATTEN_DB_11 = 3 } adc_atten_t;
+typedef enum { ADC_WIDTH_BIT_12 = 3 } adc_bits_width_t;
+typedef int adc1_channel_t; typedef int adc2_channel_t;
+typedef enum { ESP_ADC_CAL_VAL_EFUSE_VREF = 0, ESP_ADC_CAL_VAL_EFUSE_TP = 1, ESP_ADC_CAL_VAL_DEFAULT_VREF = 2 } esp_adc_cal_value_t;
+typedef struct { int x; } esp_adc_cal_characteristics_t;
+int adc1_config_width(adc_bits_width_t); int adc1_config_channel_atten(adc1_channel_t, adc_atten_t);
+int adc2_config_channel_atten(adc2_channel_t, adc_atten_t); int adc1_get_raw(adc1_channel_t);
+int adc2_get_raw(adc2_channel_t, adc_bits_width_t, int *);
+esp_adc_cal_value_t esp_adc_cal_characterize(adc_unit_t, adc_atten_t, adc_bits_width_t, uint32_t, esp_adc_cal_characteristics_t *);
+uint32_t esp_adc_cal_raw_to_voltage(uint32_t, const esp_adc_cal_characteristics_t *);
+int esp_adc_cal_check_efuse(esp_adc_cal_value_t);
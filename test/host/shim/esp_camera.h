@@ -0,0 +1,3 @@
+#pragma once
+typedef struct { int x; } camera_config_t;
+typedef enum { FRAMESIZE_VGA } framesize_t;
@@ -0,0 +1,10 @@
+#pragma once
+#include <stddef.h>
+#define MALLOC_CAP_SPIRAM (1<<10)
+#define MALLOC_CAP_INTERNAL (1<<11)
+#define MALLOC_CAP_8BIT (1<<2)
+#define MALLOC_CAP_DMA (1<<3)
+void *heap_caps_malloc(size_t, unsigned int);
+void *heap_caps_calloc(size_t, size_t, unsigned int);
+size_t heap_caps_get_free_size(unsigned int);
+size_t heap_caps_get_total_size(unsigned int);
@@ -0,0 +1,15 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+typedef int esp_err_t;
+#define ESP_OK 0
+typedef enum { ESP_PARTITION_TYPE_APP = 0, ESP_PARTITION_TYPE_DATA = 1 } esp_partition_type_t;
+typedef int esp_partition_subtype_t;
+typedef struct { esp_partition_type_t type; esp_partition_subtype_t subtype; uint32_t address; uint32_t size; char label[17]; bool encrypted; } esp_partition_t;
+typedef enum { SPI_FLASH_MMAP_DATA, SPI_FLASH_MMAP_INST } spi_flash_mmap_memory_t;
+typedef uint32_t spi_flash_mmap_handle_t;
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t, const char *);
+esp_err_t esp_partition_mmap(const esp_partition_t *, size_t, size_t, spi_flash_mmap_memory_t, const void **, spi_flash_mmap_handle_t *);
+void spi_flash_munmap(spi_flash_mmap_handle_t);
+esp_err_t esp_partition_erase_range(const esp_partition_t *, size_t, size_t);
+esp_err_t esp_partition_write(const esp_partition_t *, size_t, const void *, size_t);
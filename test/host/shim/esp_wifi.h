@@ -0,0 +1,3 @@
+#pragma once
+#include "Arduino.h"
+int esp_wifi_set_max_tx_power(int8_t);
@@ -0,0 +1,54 @@
+#pragma once
+//Host stand-in for FreeRTOS: declarations only, ArduinoShim.cpp defines what the host tests call.
+#include <stdint.h>
+typedef void *TaskHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void (*TaskFunction_t)(void *);
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xffffffffUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(x) (x)
+#define configMAX_PRIORITIES 25
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define configTICK_RATE_HZ 1000
+typedef enum { eRunning = 0, eReady, eBlocked, eSuspended, eDeleted, eInvalid } eTaskState;
+typedef struct { volatile uint32_t owner; volatile uint32_t count; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+void portENTER_CRITICAL(portMUX_TYPE *);
+void portEXIT_CRITICAL(portMUX_TYPE *);
+void portENTER_CRITICAL_ISR(portMUX_TYPE *);
+void portEXIT_CRITICAL_ISR(portMUX_TYPE *);
+void portYIELD_FROM_ISR();
+void vTaskDelay(TickType_t);
+void vTaskDelayUntil(TickType_t *, TickType_t);
+TickType_t xTaskGetTickCount();
+BaseType_t xTaskCreateUniversal(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *, BaseType_t);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *, BaseType_t);
+eTaskState eTaskGetState(TaskHandle_t);
+void vTaskSuspend(TaskHandle_t);
+void vTaskResume(TaskHandle_t);
+void vTaskDelete(TaskHandle_t);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xPortGetCoreID();
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t, TickType_t);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t);
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t);
+BaseType_t xTaskNotifyGive(TaskHandle_t);
+void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t *);
+typedef struct { TaskHandle_t xHandle; const char *pcTaskName; UBaseType_t xTaskNumber; eTaskState eCurrentState; UBaseType_t uxCurrentPriority; UBaseType_t uxBasePriority; uint32_t ulRunTimeCounter; void *pxStackBase; uint32_t usStackHighWaterMark; BaseType_t xCoreID; } TaskStatus_t;
+UBaseType_t uxTaskGetNumberOfTasks();
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *, UBaseType_t, uint32_t *);
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t);
+#define portNUM_PROCESSORS 2
+#define configGENERATE_RUN_TIME_STATS 1
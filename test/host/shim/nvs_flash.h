@@ -0,0 +1,2 @@
+#pragma once
+void nvs_flash_erase(); void nvs_flash_init();